@@ -11,9 +11,17 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <wigwag/detail/async_tasks_batch.hpp>
+#include <wigwag/detail/index_sequence.hpp>
+#include <wigwag/detail/policy_allocator.hpp>
+#include <wigwag/policies/life_assurance/none.hpp>
 #include <wigwag/task_executor.hpp>
 
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
 
 
 namespace wigwag {
@@ -22,34 +30,264 @@ namespace detail
 
 #include <wigwag/detail/disable_warnings.hpp>
 
-    template < typename Signature_, typename LifeAssurancePolicy_ >
+    template < bool... Values_ >
+    struct bool_pack
+    { };
+
+    template < bool... Values_ >
+    struct all_of : public std::is_same<bool_pack<true, Values_...>, bool_pack<Values_..., true>>
+    { };
+
+
+    template < typename Signature_, typename AllocationPolicy_ >
+    class async_payload;
+
+    // Owns a copy of the emission arguments for the asynchronous handlers. Inside an async_payload scope the first asynchronous handler
+    // copies the arguments and the rest of them share that copy. The arguments passed by non-const references are never shared.
+    template < typename R_, typename... Args_, typename AllocationPolicy_ >
+    class async_payload<R_(Args_...), AllocationPolicy_>
+    {
+    public:
+        using args_tuple = std::tuple<typename std::decay<Args_>::type...>;
+        using args_ptr = std::shared_ptr<args_tuple>;
+
+    private:
+        static const bool shareable = all_of<(!std::is_lvalue_reference<Args_>::value || std::is_const<typename std::remove_reference<Args_>::type>::value)...>::value;
+
+    private:
+        args_ptr            _args;
+        async_payload*      _prev;
+
+    public:
+        async_payload()
+            : _args(), _prev(get_current())
+        { get_current() = this; }
+
+        ~async_payload()
+        { get_current() = _prev; }
+
+        async_payload(const async_payload&) = delete;
+        async_payload& operator = (const async_payload&) = delete;
+
+        template < typename... ActualArgs_ >
+        static args_ptr get_args(ActualArgs_&&... args)
+        {
+            async_payload* p = get_current();
+            if (!shareable || !p)
+                return make_args(std::forward<ActualArgs_>(args)...);
+
+            if (!p->_args)
+                p->_args = make_args(std::forward<ActualArgs_>(args)...);
+            return p->_args;
+        }
+
+    private:
+        template < typename... ActualArgs_ >
+        static args_ptr make_args(ActualArgs_&&... args)
+        { return std::allocate_shared<args_tuple>(policy_allocator<args_tuple, AllocationPolicy_>(), std::forward<ActualArgs_>(args)...); }
+
+        static async_payload*& get_current()
+        {
+            static thread_local async_payload* current = nullptr;
+            return current;
+        }
+    };
+
+
+    // An alive execution_guard means that the handler is not destroyed yet, so the invocations may refer to the objects it owns.
+    // Without the life assurance the invocations have to share the ownership of them.
+    template < typename T_, typename LifeAssurancePolicy_, bool Guarded_ = !std::is_same<LifeAssurancePolicy_, wigwag::life_assurance::none>::value >
+    struct async_handler_ref
+    {
+        using type = T_*;
+
+        static type make(const std::shared_ptr<T_>& obj) { return obj.get(); }
+    };
+
+    template < typename T_, typename LifeAssurancePolicy_ >
+    struct async_handler_ref<T_, LifeAssurancePolicy_, false>
+    {
+        using type = std::shared_ptr<T_>;
+
+        static const type& make(const type& obj) { return obj; }
+    };
+
+
+    // The latest arguments of a conflating handler. A task is posted only when the slot becomes non-empty, the newer arguments replace the pending ones.
+    // The slot counts the tasks posted for it, when the last of them is destroyed the arguments are dropped, so the slot is never left non-empty
+    // if a task is dropped by the executor without running.
+    template < typename Signature_, typename AllocationPolicy_ >
+    class conflation_slot
+    {
+        using args_ptr = typename async_payload<Signature_, AllocationPolicy_>::args_ptr;
+
+    private:
+        std::mutex      _mutex;
+        args_ptr        _args;
+        std::size_t     _tasks_count;
+
+    public:
+        conflation_slot()
+            : _mutex(), _args(), _tasks_count(0)
+        { }
+
+        // Returns true if a task has to be posted for the arguments, that task should adopt the reference added here
+        bool put_args(args_ptr args)
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            bool was_empty = !_args;
+            _args.swap(args);
+            if (was_empty)
+                ++_tasks_count;
+            return was_empty;
+        }
+
+        args_ptr take_args()
+        {
+            args_ptr result;
+            std::lock_guard<std::mutex> l(_mutex);
+            result.swap(_args);
+            return result;
+        }
+
+        void add_task_ref()
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            ++_tasks_count;
+        }
+
+        void release_task_ref()
+        {
+            args_ptr args;
+            std::lock_guard<std::mutex> l(_mutex);
+            if (--_tasks_count == 0)
+                args.swap(_args);
+        }
+    };
+
+
+    template < typename Signature_, typename LifeAssurancePolicy_, typename AllocationPolicy_ >
     class async_handler
     {
         using life_checker = typename LifeAssurancePolicy_::life_checker;
         using execution_guard = typename LifeAssurancePolicy_::execution_guard;
 
+        using func_ptr = std::shared_ptr<const std::function<Signature_>>;
+        using func_ref_maker = async_handler_ref<const std::function<Signature_>, LifeAssurancePolicy_>;
+        using func_ref = typename func_ref_maker::type;
+        using payload = async_payload<Signature_, AllocationPolicy_>;
+        using slot = conflation_slot<Signature_, AllocationPolicy_>;
+        using slot_ptr = std::shared_ptr<slot>;
+        using slot_ref_maker = async_handler_ref<slot, LifeAssurancePolicy_>;
+        using slot_ref = typename slot_ref_maker::type;
+        using args_tuple = typename payload::args_tuple;
+        using args_ptr = typename payload::args_ptr;
+
     private:
         std::shared_ptr<task_executor>  _worker;
         life_checker                    _life_checker;
-        std::function<Signature_>       _func;
+        func_ptr                        _func;
+        slot_ptr                        _slot;
 
     public:
-        async_handler(std::shared_ptr<task_executor> worker, life_checker checker, std::function<Signature_> func)
-            : _worker(std::move(worker)), _life_checker(std::move(checker)), _func(std::move(func))
+        async_handler(std::shared_ptr<task_executor> worker, life_checker checker, std::function<Signature_> func, bool conflate = false)
+            :   _worker(std::move(worker)),
+                _life_checker(std::move(checker)),
+                _func(std::make_shared<const std::function<Signature_>>(std::move(func))),
+                _slot(conflate ? std::make_shared<slot>() : slot_ptr())
         { }
 
         template < typename... Args_ >
         void operator() (Args_&&... args) const
-        { _worker->add_task(std::bind(&async_handler::invoke_func<Args_&...>, _life_checker, _func, std::forward<Args_>(args)...)); }
+        {
+            if (_slot)
+                post_conflated(payload::get_args(std::forward<Args_>(args)...));
+            else
+                async_tasks_batch::add_task(_worker, invocation(_life_checker, func_ref_maker::make(_func), payload::get_args(std::forward<Args_>(args)...)));
+        }
 
     private:
-        template < typename... Args_ >
-        static void invoke_func(life_checker checker, const std::function<Signature_>& func, Args_&&... args)
+        void post_conflated(args_ptr args) const
         {
-            execution_guard g(checker);
-            if (g.is_alive())
-                func(std::forward<Args_>(args)...);
+            if (_slot->put_args(std::move(args)))
+                async_tasks_batch::add_task(_worker, conflated_invocation(_life_checker, func_ref_maker::make(_func), slot_ref_maker::make(_slot)));
         }
+
+        // Small enough to fit into the task without a heap allocation
+        class invocation
+        {
+        private:
+            life_checker    _life_checker;
+            func_ref        _func;
+            args_ptr        _args;
+
+        public:
+            invocation(const life_checker& checker, const func_ref& func, args_ptr args)
+                : _life_checker(checker), _func(func), _args(std::move(args))
+            { }
+
+            void operator() () const
+            {
+                execution_guard g(_life_checker);
+                if (g.is_alive())
+                    call_func(*_func, *_args, make_index_sequence<std::tuple_size<args_tuple>::value>());
+            }
+        };
+
+        // Holds a task reference of the slot, a moved-from invocation has no slot
+        class conflated_invocation
+        {
+        private:
+            life_checker    _life_checker;
+            func_ref        _func;
+            slot_ref        _slot;
+
+        public:
+            conflated_invocation(const life_checker& checker, const func_ref& func, const slot_ref& slot)
+                : _life_checker(checker), _func(func), _slot(slot)
+            { }
+
+            conflated_invocation(const conflated_invocation& other)
+                : _life_checker(other._life_checker), _func(other._func), _slot(other._slot)
+            {
+                execution_guard g(_life_checker);
+                if (_slot && g.is_alive())
+                    _slot->add_task_ref();
+                else
+                    _slot = slot_ref();
+            }
+
+            conflated_invocation(conflated_invocation&& other) WIGWAG_NOEXCEPT
+                : _life_checker(std::move(other._life_checker)), _func(std::move(other._func)), _slot(std::move(other._slot))
+            { other._slot = slot_ref(); }
+
+            ~conflated_invocation()
+            {
+                if (!_slot)
+                    return;
+
+                execution_guard g(_life_checker);
+                if (g.is_alive())
+                    _slot->release_task_ref();
+            }
+
+            conflated_invocation& operator = (const conflated_invocation&) = delete;
+
+            void operator() () const
+            {
+                execution_guard g(_life_checker);
+                if (!g.is_alive())
+                    return;
+
+                args_ptr args = _slot->take_args();
+                if (args)
+                    call_func(*_func, *args, make_index_sequence<std::tuple_size<args_tuple>::value>());
+            }
+        };
+
+        template < std::size_t... Indices_ >
+        static void call_func(const std::function<Signature_>& func, args_tuple& args, index_sequence<Indices_...>)
+        { func(std::get<Indices_>(args)...); }
     };
 
 #include <wigwag/detail/enable_warnings.hpp>
@@ -0,0 +1,166 @@
+#ifndef WIGWAG_DETAIL_ASYNC_TASKS_BATCH_HPP
+#define WIGWAG_DETAIL_ASYNC_TASKS_BATCH_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+#include <wigwag/task_executor.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <vector>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Collects the tasks posted by the asynchronous handlers during an emission and passes them to every executor in a single add_tasks call.
+    // The batches may be nested, the tasks go to the innermost one. Without an active batch the tasks are passed to the executor immediately.
+    // The groups and their task vectors are kept in a per-thread cache between the emissions, so their memory is reused.
+    class async_tasks_batch
+    {
+        struct group
+        {
+            std::shared_ptr<task_executor>  worker;
+            std::vector<task>               tasks;
+
+            group()
+                : worker(), tasks()
+            { }
+        };
+
+        using groups_vector = std::vector<group>;
+
+    private:
+        groups_vector       _groups;
+        std::size_t         _groups_count;
+        async_tasks_batch*  _prev;
+
+    public:
+        async_tasks_batch()
+            : _groups(), _groups_count(0), _prev(get_current())
+        {
+            _groups.swap(get_cached_groups());
+            get_current() = this;
+        }
+
+        async_tasks_batch(const async_tasks_batch&) = delete;
+        async_tasks_batch& operator = (const async_tasks_batch&) = delete;
+
+        // The tasks are posted by the explicit flush() only. If the emission is interrupted by an exception, the collected tasks are discarded,
+        // because posting them could throw during the stack unwinding.
+        ~async_tasks_batch()
+        {
+            if (get_current() == this)
+                get_current() = _prev;
+
+            discard_groups();
+            if (get_cached_groups().capacity() < _groups.capacity())
+                _groups.swap(get_cached_groups());
+        }
+
+        // Every executor gets its tasks even if some of them throw, the first exception is rethrown after that
+        void flush()
+        {
+            if (get_current() == this)
+                get_current() = _prev;
+
+#if WIGWAG_NOEXCEPTIONS
+            for (std::size_t i = 0; i < _groups_count; ++i)
+            {
+                _groups[i].worker->add_tasks(_groups[i].tasks.data(), _groups[i].tasks.size());
+                release_group(_groups[i]);
+            }
+            _groups_count = 0;
+#else
+            std::exception_ptr error;
+            for (std::size_t i = 0; i < _groups_count; ++i)
+            {
+                group& g = _groups[i];
+                try
+                { g.worker->add_tasks(g.tasks.data(), g.tasks.size()); }
+                catch (...)
+                {
+                    if (!error)
+                        error = std::current_exception();
+                }
+                release_group(g);
+            }
+            _groups_count = 0;
+
+            if (error)
+                std::rethrow_exception(error);
+#endif
+        }
+
+        static void add_task(const std::shared_ptr<task_executor>& worker, task t)
+        {
+            async_tasks_batch* batch = get_current();
+            if (!batch)
+            {
+                worker->add_task(std::move(t));
+                return;
+            }
+
+            batch->get_group(worker).tasks.push_back(std::move(t));
+        }
+
+    private:
+        group& get_group(const std::shared_ptr<task_executor>& worker)
+        {
+            for (std::size_t i = 0; i < _groups_count; ++i)
+                if (_groups[i].worker == worker)
+                    return _groups[i];
+
+            if (_groups_count == _groups.size())
+                _groups.emplace_back();
+
+            group& g = _groups[_groups_count];
+            g.worker = worker;
+            ++_groups_count;
+            return g;
+        }
+
+        void discard_groups()
+        {
+            for (std::size_t i = 0; i < _groups_count; ++i)
+                release_group(_groups[i]);
+            _groups_count = 0;
+        }
+
+        static void release_group(group& g)
+        {
+            g.worker.reset();
+            g.tasks.clear();
+        }
+
+        static async_tasks_batch*& get_current()
+        {
+            static thread_local async_tasks_batch* current = nullptr;
+            return current;
+        }
+
+        static groups_vector& get_cached_groups()
+        {
+            static thread_local groups_vector cached_groups;
+            return cached_groups;
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -0,0 +1,230 @@
+#ifndef WIGWAG_DETAIL_EXECUTOR_STATISTICS_COLLECTOR_HPP
+#define WIGWAG_DETAIL_EXECUTOR_STATISTICS_COLLECTOR_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/at_scope_exit.hpp>
+#include <wigwag/detail/config.hpp>
+#include <wigwag/executor_statistics.hpp>
+#include <wigwag/task_executor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // A queued task with the time it was added at, the time is zero if the statistics are disabled
+    struct timestamped_task
+    {
+        task            t;
+        std::int64_t    enqueue_time;
+
+        timestamped_task() : t(), enqueue_time(0) { }
+        timestamped_task(task&& t_, std::int64_t enqueue_time_) : t(std::move(t_)), enqueue_time(enqueue_time_) { }
+    };
+
+
+    // The counters are relaxed atomics that are read by get_statistics() without any locks. They are spread over the blocks that are picked
+    // by the calling thread, so the threads rarely share a block, and the blocks are padded, so they do not share the cache lines. The producers
+    // count the enqueued tasks in their blocks and the threads that execute the tasks update the rest of the counters in theirs. The queue depth
+    // is the difference of the sums. The producers do not know it, so the maximum depth is sampled by the consumers once in depth_sampling_period
+    // tasks and by get_statistics(), a short burst between the samples may be missed. The blocks are allocated by enable(), which should be
+    // called before the executor is used by other threads.
+    class executor_statistics_collector
+    {
+        using clock = std::chrono::steady_clock;
+        using histogram_counters = std::atomic<std::uint64_t>[executor_statistics::histogram_size];
+
+        static const std::size_t blocks_count = 8;
+        static const std::uint64_t depth_sampling_period = 16;
+
+        struct producer_block
+        {
+            std::atomic<std::uint64_t>  enqueued_count;
+            char                        padding[64];
+
+            producer_block() : enqueued_count(0) { }
+        };
+
+        struct consumer_block
+        {
+            std::atomic<std::uint64_t>  dequeued_count;
+            std::atomic<std::uint64_t>  tasks_count;
+            std::atomic<std::int64_t>   busy_time;
+            std::atomic<std::size_t>    max_queue_depth;
+            histogram_counters          wait_times;
+            histogram_counters          run_times;
+            char                        padding[64];
+
+            consumer_block() : dequeued_count(0), tasks_count(0), busy_time(0), max_queue_depth(0), wait_times(), run_times() { }
+        };
+
+        struct blocks
+        {
+            producer_block  producers[blocks_count];
+            consumer_block  consumers[blocks_count];
+
+            blocks() : producers(), consumers() { }
+        };
+
+    private:
+        std::unique_ptr<blocks>     _blocks;
+        clock::time_point           _start_time;
+
+    public:
+        executor_statistics_collector()
+            : _blocks(), _start_time()
+        { }
+
+        executor_statistics_collector(const executor_statistics_collector&) = delete;
+        executor_statistics_collector& operator = (const executor_statistics_collector&) = delete;
+
+        void enable()
+        {
+            _blocks.reset(new blocks);
+            _start_time = clock::now();
+        }
+
+        bool is_enabled() const { return _blocks != nullptr; }
+
+        // Returns the enqueue timestamp for the tasks
+        std::int64_t on_enqueue(std::size_t count)
+        {
+            if (WIGWAG_EXPECT(!_blocks, 1))
+                return 0;
+
+            add(_blocks->producers[get_block_index()].enqueued_count, count);
+            return now();
+        }
+
+        // For the tasks that leave the queue without being executed
+        void on_discard()
+        {
+            if (_blocks)
+                add(_blocks->consumers[get_block_index()].dequeued_count, 1);
+        }
+
+        template < typename Func_ >
+        void execute(std::int64_t enqueue_time, const Func_& func)
+        {
+            if (WIGWAG_EXPECT(!_blocks, 1))
+            {
+                func();
+                return;
+            }
+
+            consumer_block& b = _blocks->consumers[get_block_index()];
+            if (b.dequeued_count.fetch_add(1, std::memory_order_relaxed) % depth_sampling_period == 0)
+                update_max(b.max_queue_depth, get_queue_depth());
+
+            std::int64_t start_time = now();
+            add(b.wait_times[get_bucket(start_time - enqueue_time)], 1);
+
+            auto sg = at_scope_exit([&]
+                {
+                    std::int64_t run_time = now() - start_time;
+                    add(b.run_times[get_bucket(run_time)], 1);
+                    b.busy_time.fetch_add(run_time, std::memory_order_relaxed);
+                    add(b.tasks_count, 1);
+                } );
+            func();
+        }
+
+        executor_statistics get_statistics(std::uint64_t dropped_tasks_count) const
+        {
+            executor_statistics result;
+            if (!_blocks)
+                return result;
+
+            result.queue_depth = get_queue_depth();
+            result.max_queue_depth = result.queue_depth;
+            result.dropped_tasks_count = dropped_tasks_count;
+            result.elapsed_time = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - _start_time);
+
+            std::int64_t busy_time = 0;
+            for (const consumer_block& b : _blocks->consumers)
+            {
+                result.max_queue_depth = std::max(result.max_queue_depth, b.max_queue_depth.load(std::memory_order_relaxed));
+                result.tasks_count += b.tasks_count.load(std::memory_order_relaxed);
+                busy_time += b.busy_time.load(std::memory_order_relaxed);
+                for (std::size_t i = 0; i < executor_statistics::histogram_size; ++i)
+                {
+                    result.wait_times[i] += b.wait_times[i].load(std::memory_order_relaxed);
+                    result.run_times[i] += b.run_times[i].load(std::memory_order_relaxed);
+                }
+            }
+            result.busy_time = std::chrono::nanoseconds(busy_time);
+            return result;
+        }
+
+    private:
+        static std::int64_t now()
+        { return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now().time_since_epoch()).count(); }
+
+        static void add(std::atomic<std::uint64_t>& counter, std::uint64_t value)
+        { counter.fetch_add(value, std::memory_order_relaxed); }
+
+        static void update_max(std::atomic<std::size_t>& counter, std::size_t value)
+        {
+            std::size_t max_value = counter.load(std::memory_order_relaxed);
+            while (value > max_value && !counter.compare_exchange_weak(max_value, value, std::memory_order_relaxed))
+                ;
+        }
+
+        // The tasks are counted before they are queued, so the sums may lag behind each other only while the blocks are being read
+        std::size_t get_queue_depth() const
+        {
+            std::uint64_t dequeued = 0, enqueued = 0;
+            for (const consumer_block& b : _blocks->consumers)
+                dequeued += b.dequeued_count.load(std::memory_order_relaxed);
+            for (const producer_block& b : _blocks->producers)
+                enqueued += b.enqueued_count.load(std::memory_order_relaxed);
+            return enqueued > dequeued ? static_cast<std::size_t>(enqueued - dequeued) : 0;
+        }
+
+        // The threads get the blocks in turn
+        static std::size_t get_block_index()
+        {
+            static std::atomic<std::size_t> next_index(0);
+            static thread_local std::size_t index = next_index++ % blocks_count;
+            return index;
+        }
+
+        static std::size_t get_bucket(std::int64_t duration)
+        {
+            if (duration < 2)
+                return 0;
+#if defined(__GNUC__) || defined(__clang__)
+            std::size_t bucket = 63 - __builtin_clzll(static_cast<unsigned long long>(duration));
+#else
+            std::size_t bucket = 0;
+            for (std::uint64_t d = static_cast<std::uint64_t>(duration); d > 1; d >>= 1)
+                ++bucket;
+#endif
+            return bucket < executor_statistics::histogram_size ? bucket : executor_statistics::histogram_size - 1;
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -0,0 +1,197 @@
+#ifndef WIGWAG_DETAIL_FLAT_LIST_HPP
+#define WIGWAG_DETAIL_FLAT_LIST_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+#include <wigwag/detail/iterator_base.hpp>
+
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    template < typename T_ >
+    class flat_list;
+
+
+    class flat_list_node
+    {
+        template < typename T_ >
+        friend class flat_list;
+
+    private:
+        size_t      _index;
+
+    public:
+        flat_list_node() : _index(0) { }
+    };
+
+
+    // Keeps pointers to the nodes in a contiguous array, and the iterators walk that array by index, so that advancing an iterator does not touch the nodes.
+    // The nodes themselves stay on the heap, because the tokens and the life assurance refer to them after they are erased.
+    // Erasing a node leaves a hole that is skipped by the iterators, the holes are squeezed out once they occupy a half of the array.
+    // Squeezing moves the nodes, so it bumps the generation, and an iterator from an older generation looks its position up in its node before advancing.
+    template < typename T_ >
+    class flat_list
+    {
+        static_assert(std::is_base_of<flat_list_node, T_>::value, "flat_list_node should be a base of T_");
+
+        using nodes_vector = std::vector<T_*>;
+
+    public:
+        class const_iterator;
+
+        class iterator : public iterator_base<iterator, std::forward_iterator_tag, T_>
+        {
+            friend class const_iterator;
+
+        private:
+            const flat_list*    _list;
+            T_*                 _node;
+            size_t              _index;
+            size_t              _generation;
+
+        public:
+            explicit iterator(const flat_list* list = nullptr, size_t index = 0)
+                : _list(list), _node(list ? list->node_at(index) : nullptr), _index(index), _generation(list ? list->_generation : 0)
+            { }
+
+            T_& dereference() const { return *_node; }
+            bool equal(iterator other) const { return _node == other._node; }
+            void increment() { _list->advance(_node, _index, _generation); }
+        };
+
+        class const_iterator : public iterator_base<const_iterator, std::forward_iterator_tag, const T_>
+        {
+        private:
+            const flat_list*    _list;
+            T_*                 _node;
+            size_t              _index;
+            size_t              _generation;
+
+        public:
+            const_iterator(iterator it) : _list(it._list), _node(it._node), _index(it._index), _generation(it._generation) { }
+
+            explicit const_iterator(const flat_list* list = nullptr, size_t index = 0)
+                : _list(list), _node(list ? list->node_at(index) : nullptr), _index(index), _generation(list ? list->_generation : 0)
+            { }
+
+            const T_& dereference() const { return *_node; }
+            bool equal(const_iterator other) const { return _node == other._node; }
+            void increment() { _list->advance(_node, _index, _generation); }
+        };
+
+    private:
+        nodes_vector    _nodes;
+        size_t          _holes_count;
+        size_t          _generation;
+
+    public:
+        flat_list() : _holes_count(0), _generation(0) { }
+
+        flat_list(const flat_list&) = delete;
+        flat_list& operator = (const flat_list&) = delete;
+
+        iterator begin() { return iterator(this, first_index(0)); }
+        iterator end() { return iterator(this, _nodes.size()); }
+        iterator pre_end() { return iterator(this, _nodes.empty() ? 0 : _nodes.size() - 1); }
+
+        const_iterator begin() const { return const_iterator(this, first_index(0)); }
+        const_iterator end() const { return const_iterator(this, _nodes.size()); }
+        const_iterator pre_end() const { return const_iterator(this, _nodes.empty() ? 0 : _nodes.size() - 1); }
+
+        bool empty() const { return _nodes.empty(); }
+        size_t size() const { return _nodes.size() - _holes_count; }
+
+        bool contains(const T_& node) const
+        {
+            size_t i = get_index(node);
+            return i < _nodes.size() && _nodes[i] == &node;
+        }
+
+        void push_back(T_& node)
+        {
+            get_index(node) = _nodes.size();
+            _nodes.push_back(&node);
+        }
+
+        void erase(T_& node)
+        {
+            if (!contains(node))
+                return;
+
+            _nodes[get_index(node)] = nullptr;
+            ++_holes_count;
+
+            while (!_nodes.empty() && !_nodes.back())
+            {
+                _nodes.pop_back();
+                --_holes_count;
+            }
+
+            if (_holes_count * 2 > _nodes.size())
+                compact();
+        }
+
+    private:
+        static size_t& get_index(T_& node) { return static_cast<flat_list_node&>(node)._index; }
+        static size_t get_index(const T_& node) { return static_cast<const flat_list_node&>(node)._index; }
+
+        T_* node_at(size_t i) const
+        { return i < _nodes.size() ? _nodes[i] : nullptr; }
+
+        size_t first_index(size_t i) const
+        {
+            while (i < _nodes.size() && !_nodes[i])
+                ++i;
+            return i;
+        }
+
+        void advance(T_*& node, size_t& index, size_t& generation) const
+        {
+            if (WIGWAG_EXPECT(generation != _generation, 0))
+            {
+                index = node ? get_index(*node) : _nodes.size();
+                generation = _generation;
+            }
+
+            index = first_index(index + 1);
+            node = node_at(index);
+        }
+
+        void compact()
+        {
+            size_t j = 0;
+            for (size_t i = 0; i < _nodes.size(); ++i)
+            {
+                if (!_nodes[i])
+                    continue;
+                get_index(*_nodes[i]) = j;
+                _nodes[j++] = _nodes[i];
+            }
+            _nodes.resize(j);
+            _holes_count = 0;
+            ++_generation;
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
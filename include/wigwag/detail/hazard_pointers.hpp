@@ -0,0 +1,259 @@
+#ifndef WIGWAG_DETAIL_HAZARD_POINTERS_HPP
+#define WIGWAG_DETAIL_HAZARD_POINTERS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // A type-stable life flag. The state is odd while the owner is alive, each retirement and each reuse increments it, so a stale reader
+    // never mistakes a reused slot for the one it has checked. The slots are never returned to the system.
+    class life_slot
+    {
+        friend class hazard_pointers;
+
+    private:
+        std::atomic<std::uint64_t>      _state;
+        mutable std::atomic<unsigned>   _pins;
+        life_slot*                      _next_free;
+
+    public:
+        life_slot() : _state(0), _pins(0), _next_free(nullptr) { }
+
+        life_slot(const life_slot&) = delete;
+        life_slot& operator = (const life_slot&) = delete;
+
+        std::uint64_t get_state() const
+        { return _state.load(std::memory_order_acquire); }
+    };
+
+
+    // Every thread publishes the slots it is currently reading in its own record, so the readers never write to the shared data. A retiring
+    // thread marks the slot dead and then waits until no record points to it. The guards that do not fit into the record pin the slot itself.
+    class hazard_pointers
+    {
+        static const std::size_t hazards_count = 16;
+        static const std::size_t slots_chunk_size = 64;
+
+        struct record
+        {
+            std::atomic<const life_slot*>   hazards[hazards_count];
+            std::atomic<bool>               in_use;
+            record*                         next;
+            std::size_t                     depth;
+            char                            padding[64];
+
+            record() : in_use(true), next(nullptr), depth(0)
+            {
+                for (std::size_t i = 0; i < hazards_count; ++i)
+                    hazards[i].store(nullptr, std::memory_order_relaxed);
+            }
+        };
+
+        class slots_pool
+        {
+        private:
+            std::mutex      _mutex;
+            life_slot*      _free_slots;
+
+        public:
+            slots_pool() : _mutex(), _free_slots(nullptr) { }
+
+            life_slot* take()
+            {
+                std::lock_guard<std::mutex> l(_mutex);
+                if (!_free_slots)
+                {
+                    life_slot* chunk = new life_slot[slots_chunk_size];
+                    for (std::size_t i = 0; i < slots_chunk_size; ++i)
+                        push(&chunk[i]);
+                }
+
+                life_slot* s = _free_slots;
+                _free_slots = s->_next_free;
+                return s;
+            }
+
+            void give(life_slot* s)
+            {
+                std::lock_guard<std::mutex> l(_mutex);
+                push(s);
+            }
+
+        private:
+            void push(life_slot* s)
+            {
+                s->_next_free = _free_slots;
+                _free_slots = s;
+            }
+        };
+
+        class record_holder
+        {
+        private:
+            record*     _record;
+
+        public:
+            record_holder() : _record(acquire_record()) { get_record_ptr() = _record; }
+
+            ~record_holder()
+            {
+                _record->in_use.store(false, std::memory_order_release);
+                get_record_ptr() = nullptr;
+                get_record_finished() = true;
+            }
+
+            record_holder(const record_holder&) = delete;
+            record_holder& operator = (const record_holder&) = delete;
+        };
+
+    public:
+        class guard
+        {
+        private:
+            const life_slot&                    _slot;
+            record*                             _record;
+            std::atomic<const life_slot*>*      _hazard;
+
+        public:
+            guard(const life_slot& slot)
+                : _slot(slot), _record(get_record()), _hazard(nullptr)
+            {
+                if (WIGWAG_EXPECT(_record && _record->depth < hazards_count, 1))
+                {
+                    _hazard = &_record->hazards[_record->depth++];
+                    _hazard->store(&slot, std::memory_order_relaxed);
+                }
+                else
+                    _slot._pins.fetch_add(1, std::memory_order_relaxed);
+
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+
+            ~guard()
+            {
+                if (WIGWAG_EXPECT(_hazard != nullptr, 1))
+                {
+                    _hazard->store(nullptr, std::memory_order_release);
+                    --_record->depth;
+                }
+                else
+                    _slot._pins.fetch_sub(1, std::memory_order_release);
+            }
+
+            guard(const guard&) = delete;
+            guard& operator = (const guard&) = delete;
+        };
+
+        static life_slot* allocate_slot()
+        {
+            life_slot* s = get_slots_pool().take();
+            s->_state.store(s->_state.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            return s;
+        }
+
+        // Waits for the guards of other threads, so it must not be called under a guard of the same slot
+        static void retire_slot(life_slot* s)
+        {
+            s->_state.store(s->_state.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            for (record* r = get_records_head().load(std::memory_order_acquire); r; r = r->next)
+                for (std::size_t i = 0; i < hazards_count; ++i)
+                    for (int j = 0; r->hazards[i].load(std::memory_order_acquire) == s; ++j)
+                        backoff(j);
+
+            for (int j = 0; s->_pins.load(std::memory_order_acquire) != 0; ++j)
+                backoff(j);
+
+            get_slots_pool().give(s);
+        }
+
+    private:
+        static void backoff(int iteration)
+        {
+            if (iteration < 64)
+                std::this_thread::yield();
+            else
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        static record* acquire_record()
+        {
+            std::atomic<record*>& head = get_records_head();
+            for (record* r = head.load(std::memory_order_acquire); r; r = r->next)
+            {
+                bool in_use = false;
+                if (!r->in_use.load(std::memory_order_relaxed) && r->in_use.compare_exchange_strong(in_use, true, std::memory_order_acquire))
+                    return r;
+            }
+
+            record* r = new record;
+            r->next = head.load(std::memory_order_relaxed);
+            while (!head.compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed))
+                ;
+            return r;
+        }
+
+        static record* get_record()
+        {
+            record* r = get_record_ptr();
+            if (WIGWAG_EXPECT(r != nullptr, 1) || get_record_finished())
+                return r;
+
+            static thread_local record_holder holder;
+            return get_record_ptr();
+        }
+
+        // Trivially destructible, so these stay valid while the thread-local destructors run
+        static record*& get_record_ptr()
+        {
+            static thread_local record* record_ptr = nullptr;
+            return record_ptr;
+        }
+
+        static bool& get_record_finished()
+        {
+            static thread_local bool finished = false;
+            return finished;
+        }
+
+        static std::atomic<record*>& get_records_head()
+        {
+            static std::atomic<record*>* instance = new std::atomic<record*>(nullptr); // Never destroyed, the records are scanned by the static destructors
+            return *instance;
+        }
+
+        static slots_pool& get_slots_pool()
+        {
+            static slots_pool* instance = new slots_pool; // Never destroyed, the slots may be retired by the static destructors
+            return *instance;
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef WIGWAG_DETAIL_INDEX_SEQUENCE_HPP
+#define WIGWAG_DETAIL_INDEX_SEQUENCE_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <cstddef>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    template < std::size_t... Indices_ >
+    struct index_sequence
+    { };
+
+
+    template < std::size_t N_, std::size_t... Indices_ >
+    struct make_index_sequence_impl
+    { using type = typename make_index_sequence_impl<N_ - 1, N_ - 1, Indices_...>::type; };
+
+    template < std::size_t... Indices_ >
+    struct make_index_sequence_impl<0, Indices_...>
+    { using type = index_sequence<Indices_...>; };
+
+
+    template < std::size_t N_ >
+    using make_index_sequence = typename make_index_sequence_impl<N_>::type;
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
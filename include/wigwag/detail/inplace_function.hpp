@@ -0,0 +1,164 @@
+#ifndef WIGWAG_DETAIL_INPLACE_FUNCTION_HPP
+#define WIGWAG_DETAIL_INPLACE_FUNCTION_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    template < typename Signature_, std::size_t Capacity_ >
+    class inplace_function;
+
+    // Keeps the callables that fit into Capacity_ bytes and are nothrow movable inside the object, the rest are put to the heap.
+    // The call goes through a single static table per callable type, there is no check for emptiness on the call path.
+    template < typename R_, typename... Args_, std::size_t Capacity_ >
+    class inplace_function<R_(Args_...), Capacity_>
+    {
+        static_assert(Capacity_ >= sizeof(void*), "Capacity_ should be enough to hold a pointer");
+
+        using storage = typename std::aligned_storage<Capacity_, WIGWAG_ALIGNOF(double)>::type;
+
+        struct vtable
+        {
+            R_ (*invoke)(storage&, Args_&&...);
+            void (*copy)(storage&, const storage&);
+            void (*move)(storage&, storage&);
+            void (*destroy)(storage&);
+        };
+
+        template < typename F_ >
+        struct is_stored_inplace
+        {
+            static const bool value = sizeof(F_) <= sizeof(storage) && WIGWAG_ALIGNOF(storage) % WIGWAG_ALIGNOF(F_) == 0 && std::is_nothrow_move_constructible<F_>::value;
+        };
+
+        struct empty_ops
+        {
+            static R_ invoke(storage&, Args_&&...) { WIGWAG_THROW("Empty inplace_function invoked!"); }
+            static void copy(storage&, const storage&) { }
+            static void move(storage&, storage&) { }
+            static void destroy(storage&) { }
+        };
+
+        template < typename F_, bool Inplace_ = is_stored_inplace<F_>::value >
+        struct ops
+        {
+            static F_& get(storage& s) { return *reinterpret_cast<F_*>(&s); }
+            static const F_& get(const storage& s) { return *reinterpret_cast<const F_*>(&s); }
+
+            template < typename G_ >
+            static void create(storage& s, G_&& f) { new(&s) F_(std::forward<G_>(f)); }
+
+            static R_ invoke(storage& s, Args_&&... args) { return static_cast<R_>(get(s)(std::forward<Args_>(args)...)); }
+            static void copy(storage& dst, const storage& src) { new(&dst) F_(get(src)); }
+            static void move(storage& dst, storage& src) { new(&dst) F_(std::move(get(src))); get(src).~F_(); }
+            static void destroy(storage& s) { get(s).~F_(); }
+        };
+
+        template < typename F_ >
+        struct ops<F_, false>
+        {
+            static F_* get(const storage& s) { return *reinterpret_cast<F_* const*>(&s); }
+
+            template < typename G_ >
+            static void create(storage& s, G_&& f) { new(&s) F_*(new F_(std::forward<G_>(f))); }
+
+            static R_ invoke(storage& s, Args_&&... args) { return static_cast<R_>((*get(s))(std::forward<Args_>(args)...)); }
+            static void copy(storage& dst, const storage& src) { new(&dst) F_*(new F_(*get(src))); }
+            static void move(storage& dst, storage& src) { new(&dst) F_*(get(src)); }
+            static void destroy(storage& s) { delete get(s); }
+        };
+
+        template < typename F_ >
+        using enable_if_callable = typename std::enable_if<!std::is_same<typename std::decay<F_>::type, inplace_function>::value && !std::is_same<typename std::decay<F_>::type, std::nullptr_t>::value>::type;
+
+    private:
+        const vtable*       _vtable;
+        mutable storage     _storage;
+
+    public:
+        inplace_function() WIGWAG_NOEXCEPT
+            : _vtable(&get_vtable<empty_ops>()), _storage()
+        { }
+
+        inplace_function(std::nullptr_t) WIGWAG_NOEXCEPT
+            : _vtable(&get_vtable<empty_ops>()), _storage()
+        { }
+
+        template < typename F_, typename = enable_if_callable<F_> >
+        inplace_function(F_&& f)
+            : _vtable(&get_vtable<ops<typename std::decay<F_>::type>>()), _storage()
+        { ops<typename std::decay<F_>::type>::create(_storage, std::forward<F_>(f)); }
+
+        inplace_function(const inplace_function& other)
+            : _vtable(other._vtable), _storage()
+        { _vtable->copy(_storage, other._storage); }
+
+        inplace_function(inplace_function&& other) WIGWAG_NOEXCEPT
+            : _vtable(other._vtable), _storage()
+        {
+            _vtable->move(_storage, other._storage);
+            other._vtable = &get_vtable<empty_ops>();
+        }
+
+        ~inplace_function()
+        { _vtable->destroy(_storage); }
+
+        inplace_function& operator = (const inplace_function& other)
+        {
+            inplace_function tmp(other);
+            return *this = std::move(tmp);
+        }
+
+        inplace_function& operator = (inplace_function&& other) WIGWAG_NOEXCEPT
+        {
+            if (this == &other)
+                return *this;
+
+            _vtable->destroy(_storage);
+            _vtable = other._vtable;
+            _vtable->move(_storage, other._storage);
+            other._vtable = &get_vtable<empty_ops>();
+            return *this;
+        }
+
+        explicit operator bool() const WIGWAG_NOEXCEPT
+        { return _vtable != &get_vtable<empty_ops>(); }
+
+        R_ operator() (Args_... args) const
+        { return _vtable->invoke(_storage, std::forward<Args_>(args)...); }
+
+    private:
+        template < typename Ops_ >
+        static const vtable& get_vtable()
+        {
+            static const vtable instance = { &Ops_::invoke, &Ops_::copy, &Ops_::move, &Ops_::destroy };
+            return instance;
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -115,6 +115,8 @@ namespace detail
         bool empty() const { return _root.unlinked(); }
         size_t size() const { return std::distance(begin(), end()); }
 
+        bool contains(const T_& node) const { return !node.unlinked(); }
+
         void push_back(T_& node) { node.insert_before(_root); }
         void erase(T_& node) { node.unlink(); }
     };
@@ -14,13 +14,20 @@
 #include <wigwag/detail/at_scope_exit.hpp>
 #include <wigwag/detail/config.hpp>
 #include <wigwag/detail/enabler.hpp>
-#include <wigwag/detail/intrusive_list.hpp>
 #include <wigwag/detail/intrusive_ptr.hpp>
 #include <wigwag/detail/intrusive_ref_counter.hpp>
+#include <wigwag/detail/policies/threading/policy_concept.hpp>
 #include <wigwag/detail/storage_for.hpp>
 #include <wigwag/handler_attributes.hpp>
+#include <wigwag/policies/exception_handling/none.hpp>
+#include <wigwag/policies/life_assurance/none.hpp>
 #include <wigwag/token.hpp>
 
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
 
 namespace wigwag {
 namespace detail
@@ -40,23 +47,33 @@ namespace detail
     { static const bool value = std::is_constructible<ShouldBeConstructible_, Arg_>::value; };
 
 
+    struct locked_emission_tag { };
+    struct shared_emission_tag { };
+    struct snapshot_emission_tag { };
+
+    struct guarded_invocation_tag { };
+    struct plain_invocation_tag { };
+
+
     template <
             typename HandlerType_,
             typename ExceptionHandlingPolicy_,
             typename ThreadingPolicy_,
             typename StatePopulatingPolicy_,
             typename LifeAssurancePolicy_,
-            typename RefCounterPolicy_
+            typename RefCounterPolicy_,
+            typename HandlersStoragePolicy_,
+            typename AllocationPolicy_
         >
     class listenable_impl
-        :   private intrusive_ref_counter<RefCounterPolicy_, listenable_impl<HandlerType_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_>>,
+        :   private intrusive_ref_counter<RefCounterPolicy_, listenable_impl<HandlerType_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_, HandlersStoragePolicy_, AllocationPolicy_>>,
             protected LifeAssurancePolicy_::shared_data,
             protected ExceptionHandlingPolicy_,
             protected ThreadingPolicy_::lock_primitive,
             protected StatePopulatingPolicy_::template handler_processor<HandlerType_>
     {
-        friend class intrusive_ref_counter<RefCounterPolicy_, listenable_impl<HandlerType_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_>>;
-        using ref_counter_base = intrusive_ref_counter<RefCounterPolicy_, listenable_impl<HandlerType_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_>>;
+        friend class intrusive_ref_counter<RefCounterPolicy_, listenable_impl<HandlerType_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_, HandlersStoragePolicy_, AllocationPolicy_>>;
+        using ref_counter_base = intrusive_ref_counter<RefCounterPolicy_, listenable_impl<HandlerType_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_, HandlersStoragePolicy_, AllocationPolicy_>>;
 
     public:
         using handler_type = HandlerType_;
@@ -70,66 +87,102 @@ namespace detail
         using execution_guard = typename LifeAssurancePolicy_::execution_guard;
 
     protected:
-        class handler_node : public token::implementation, private life_assurance, private detail::intrusive_list_node
+        class handler_node;
+
+        using handlers_storage = typename HandlersStoragePolicy_::template container<handler_node>;
+        using handlers_container = typename threading::handlers_container_picker<ThreadingPolicy_, handler_node, handlers_storage>::type;
+        using emission_tag = typename std::conditional<threading::has_snapshot_container<ThreadingPolicy_>::value, snapshot_emission_tag,
+                typename std::conditional<threading::has_lock_shared<ThreadingPolicy_>::value, shared_emission_tag, locked_emission_tag>::type>::type;
+        using invocation_tag = typename std::conditional<
+                std::is_same<LifeAssurancePolicy_, wigwag::life_assurance::none>::value && std::is_same<ExceptionHandlingPolicy_, wigwag::exception_handling::none>::value,
+                plain_invocation_tag, guarded_invocation_tag>::type;
+
+        class handler_node : public life_assurance, private HandlersStoragePolicy_::node_base
         {
-            friend class detail::intrusive_list<handler_node>;
+            friend handlers_storage;
 
         private:
             intrusive_ptr<listenable_impl>  _listenable_impl;
             storage_for<handler_type>       _handler;
+            bool                            _retired;
 
         public:
             template < typename MakeHandlerFunc_ >
             handler_node(intrusive_ptr<listenable_impl> impl, const MakeHandlerFunc_& mhf)
-                : _listenable_impl(std::move(impl)), _handler(mhf(life_checker(*_listenable_impl, *this)))
+                : _listenable_impl(std::move(impl)), _handler(mhf(life_checker(*_listenable_impl, *this))), _retired(false)
             { _listenable_impl->get_handlers_container().push_back(*this); }
 
             handler_node(intrusive_ptr<listenable_impl> impl, handler_type handler)
-                : _listenable_impl(std::move(impl)), _handler(std::move(handler))
+                : _listenable_impl(std::move(impl)), _handler(std::move(handler)), _retired(false)
             { _listenable_impl->get_handlers_container().push_back(*this); }
 
             virtual ~handler_node()
             { }
 
+            static void* operator new(std::size_t size)
+            { return AllocationPolicy_::allocate(size); }
+
+            static void operator delete(void* p, std::size_t size)
+            { AllocationPolicy_::deallocate(p, size); }
+
             virtual void release_token_impl()
             {
-                life_assurance::release_life_assurance(*_listenable_impl);
+                token::implementation* self = this;
+                release_token_impls(&self, 1);
+            }
+
+            virtual const void* get_batch_key() const
+            { return _listenable_impl.get(); }
+
+            // All the nodes belong to the same listenable_impl, so its lock is taken once for all of them
+            virtual void release_token_impls(token::implementation** impls, std::size_t count)
+            {
+                intrusive_ptr<listenable_impl> impl(_listenable_impl);
 
-                if (!suppress_populator() && _listenable_impl->get_handler_processor().has_withdraw_state())
+                for (std::size_t i = 0; i < count; ++i)
+                    get_node(impls[i]).release_life_assurance(*impl);
+
+                if (impl->get_handler_processor().has_withdraw_state())
                 {
-                    _listenable_impl->get_lock_primitive().lock_nonrecursive();
-                    auto sg = detail::at_scope_exit([&] { _listenable_impl->get_lock_primitive().unlock_nonrecursive(); } );
-                    _listenable_impl->get_handler_processor().withdraw_state(_handler.ref());
+                    impl->get_lock_primitive().lock_nonrecursive();
+                    auto sg = detail::at_scope_exit([&] { impl->get_lock_primitive().unlock_nonrecursive(); } );
+                    for (std::size_t i = 0; i < count; ++i)
+                        if (!get_node(impls[i]).suppress_populator())
+                            impl->get_handler_processor().withdraw_state(get_node(impls[i])._handler.ref());
                 }
 
-                _handler.ref().~handler_type();
+                for (std::size_t i = 0; i < count; ++i)
+                    get_node(impls[i])._handler.ref().~handler_type();
 
-                if (life_assurance::release_node())
-                {
-                    {
-                        _listenable_impl->get_lock_primitive().lock_nonrecursive();
-                        auto sg = detail::at_scope_exit([&] { _listenable_impl->get_lock_primitive().unlock_nonrecursive(); } );
-                        _listenable_impl->get_handlers_container().erase(*this);
-                    }
-                    delete this;
-                }
+                impl->release_nodes(impls, count);
             }
 
+            static handler_node& get_node(token::implementation* impl)
+            { return static_cast<handler_node&>(*impl); }
+
             bool should_be_finalized() const
             { return life_assurance::node_should_be_released(); }
 
-            void finalize_node()
+            bool release_ref()
+            { return life_assurance::release_node(); }
+
+            void release_refs(int count)
             {
-                if (life_assurance::release_node())
-                {
-                    _listenable_impl->get_handlers_container().erase(*this);
-                    delete this;
-                }
+                for (int i = 0; i < count; ++i)
+                    if (release_ref())
+                    {
+                        delete this;
+                        return;
+                    }
             }
 
             handler_type& get_handler() { return _handler.ref(); }
             const life_assurance& get_life_assurance() const { return *this; }
 
+            // Only accessed under the lock of the listenable_impl
+            bool is_retired() const { return _retired; }
+            void retire() { _retired = true; }
+
         protected:
             virtual bool suppress_populator()
             { return false; }
@@ -151,9 +204,23 @@ namespace detail
             { return contains_flag(_attributes, handler_attributes::suppress_populator); }
         };
 
-        using handlers_container = detail::intrusive_list<handler_node>;
+        // Nodes are never unlinked while somebody iterates over them. A released node is either counted in released_count (and is found
+        // later by its refcount) or, if nobody holds it anymore, marked as retired and put to retired_nodes. Both are collected when the last emitter
+        // leaves or on connect.
+        struct emission_state
+        {
+            unsigned int                    emitters_count;
+            std::atomic<unsigned int>       released_count;
+            std::vector<handler_node*>      retired_nodes;
+
+            emission_state() : emitters_count(0), released_count(0), retired_nodes() { }
+
+            bool has_garbage() const
+            { return !retired_nodes.empty() || released_count.load(std::memory_order_relaxed) != 0; }
+        };
 
         handlers_container                  _handlers;
+        emission_state                      _emission_state;
 
     public:
         template <
@@ -201,10 +268,7 @@ namespace detail
 
 
         void finalize_nodes()
-        {
-            for (auto it = _handlers.begin(); it != _handlers.end();)
-                (it++)->finalize_node();
-        }
+        { finalize_nodes(emission_tag()); }
 
         void add_ref() { ref_counter_base::add_ref(); }
         void release() { ref_counter_base::release(); }
@@ -214,43 +278,275 @@ namespace detail
             get_lock_primitive().lock_nonrecursive();
             auto sg = detail::at_scope_exit([&] { get_lock_primitive().unlock_nonrecursive(); } );
 
+            collect_nodes(emission_tag());
+
             if (!contains_flag(attributes, handler_attributes::suppress_populator) && get_handler_processor().has_populate_state())
                 get_exception_handler().handle_exceptions([&] { get_handler_processor().populate_state(handler); });
 
             return create_node(attributes, std::move(handler));
         }
 
+        // Takes the lock and collects the garbage once for all the handlers
+        template < typename Iterator_ >
+        std::vector<token> connect_many(Iterator_ begin, Iterator_ end, handler_attributes attributes)
+        {
+            std::vector<token> tokens;
+            reserve_tokens(tokens, begin, end, typename std::iterator_traits<Iterator_>::iterator_category());
+
+            get_lock_primitive().lock_nonrecursive();
+            auto sg = detail::at_scope_exit([&] { get_lock_primitive().unlock_nonrecursive(); } );
+
+            collect_nodes(emission_tag());
+
+            bool populate = !contains_flag(attributes, handler_attributes::suppress_populator) && get_handler_processor().has_populate_state();
+            auto create_nodes = [&]
+                {
+                    for (; begin != end; ++begin)
+                    {
+                        handler_type handler(*begin);
+                        if (populate)
+                            get_exception_handler().handle_exceptions([&] { get_handler_processor().populate_state(handler); });
+                        tokens.push_back(create_node(attributes, std::move(handler)));
+                    }
+                };
+            push_many(create_nodes, emission_tag());
+
+            return tokens;
+        }
+
+        template < typename PushNodesFunc_, typename EmissionTag_ >
+        void push_many(const PushNodesFunc_& push_nodes, EmissionTag_)
+        { push_nodes(); }
+
+        // The snapshot is published once, not after each of the nodes
+        template < typename PushNodesFunc_ >
+        void push_many(const PushNodesFunc_& push_nodes, snapshot_emission_tag)
+        { _handlers.push_many(push_nodes); }
+
+        template < typename Iterator_ >
+        static void reserve_tokens(std::vector<token>& tokens, Iterator_ begin, Iterator_ end, std::forward_iterator_tag)
+        { tokens.reserve(std::distance(begin, end)); }
+
+        template < typename Iterator_ >
+        static void reserve_tokens(std::vector<token>&, Iterator_, Iterator_, std::input_iterator_tag)
+        { }
+
         template < typename InvokeListenerFunc_ >
         void invoke(InvokeListenerFunc_&& invoke_listener_func)
+        { invoke(invoke_listener_func, emission_tag()); }
+
+        const lock_primitive& get_lock_primitive() const { return *this; }
+
+    protected:
+        template < typename InvokeListenerFunc_ >
+        void invoke(InvokeListenerFunc_& invoke_listener_func, locked_emission_tag)
         {
             get_lock_primitive().lock_recursive();
-            auto sg = detail::at_scope_exit([&] { get_lock_primitive().unlock_recursive(); } );
+            ++_emission_state.emitters_count;
+            auto sg = detail::at_scope_exit([&]
+                {
+                    if (--_emission_state.emitters_count == 0 && WIGWAG_EXPECT(_emission_state.has_garbage(), 0))
+                        collect_nodes();
+                    get_lock_primitive().unlock_recursive();
+                } );
 
-            if (this->_handlers.empty())
+            if (_handlers.empty())
                 return;
-            auto it = this->_handlers.begin(), e = this->_handlers.pre_end();
+            auto it = _handlers.begin(), e = _handlers.pre_end();
 
             bool last_iter = false;
             while (!last_iter)
             {
                 last_iter = it == e;
 
-                if (it->should_be_finalized())
+                if (WIGWAG_EXPECT(it->is_retired(), 0))
                 {
-                    (it++)->finalize_node();
+                    ++it;
                     continue;
                 }
 
-                execution_guard g(get_life_assurance_shared_data(), it->get_life_assurance());
-                if (g.is_alive())
-                    get_exception_handler().handle_exceptions(invoke_listener_func, it->get_handler());
+                invoke_handler(invoke_listener_func, *it, invocation_tag());
                 ++it;
             }
         }
 
-        const lock_primitive& get_lock_primitive() const { return *this; }
+        template < typename InvokeListenerFunc_ >
+        void invoke(InvokeListenerFunc_& invoke_listener_func, shared_emission_tag)
+        {
+            get_lock_primitive().lock_shared();
+            auto sg = detail::at_scope_exit([&] { get_lock_primitive().unlock_shared(); } );
+
+            for (auto& n : _handlers)
+                invoke_handler(invoke_listener_func, n, invocation_tag());
+        }
+
+        template < typename InvokeListenerFunc_ >
+        void invoke(InvokeListenerFunc_& invoke_listener_func, snapshot_emission_tag)
+        {
+            unsigned epoch = _handlers.lock_snapshot();
+            auto sg = detail::at_scope_exit([&] { if (_handlers.unlock_snapshot(epoch)) collect_retired(); } );
+
+            auto snapshot = _handlers.get_snapshot();
+            if (!snapshot)
+                return;
+
+            for (handler_node* n : *snapshot)
+                invoke_handler(invoke_listener_func, *n, invocation_tag());
+        }
+
+        template < typename InvokeListenerFunc_ >
+        void invoke_handler(InvokeListenerFunc_& invoke_listener_func, handler_node& n, guarded_invocation_tag)
+        {
+            execution_guard g(get_life_assurance_shared_data(), n.get_life_assurance());
+            if (g.is_alive())
+                get_exception_handler().handle_exceptions(invoke_listener_func, n.get_handler());
+        }
+
+        // Nothing to check and nothing to catch, so the handler is just called
+        template < typename InvokeListenerFunc_ >
+        void invoke_handler(InvokeListenerFunc_& invoke_listener_func, handler_node& n, plain_invocation_tag)
+        { invoke_listener_func(n.get_handler()); }
+
+        void release_nodes(token::implementation** impls, std::size_t count)
+        { release_nodes(impls, count, emission_tag()); }
+
+        template < typename EmissionTag_ >
+        void release_nodes(token::implementation** impls, std::size_t count, EmissionTag_)
+        {
+            std::size_t removed_count = 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (handler_node::get_node(impls[i]).release_ref())
+                    impls[removed_count++] = impls[i];
+                else
+                    ++_emission_state.released_count;
+            }
+
+            if (removed_count == 0)
+                return;
+
+            {
+                get_lock_primitive().lock_nonrecursive();
+                auto sg = detail::at_scope_exit([&] { get_lock_primitive().unlock_nonrecursive(); } );
+
+                std::size_t deleted_count = 0;
+                for (std::size_t i = 0; i < removed_count; ++i)
+                {
+                    handler_node& node = handler_node::get_node(impls[i]);
+                    if (_handlers.contains(node))
+                    {
+                        if (_emission_state.emitters_count != 0)
+                        {
+                            node.retire();
+                            _emission_state.retired_nodes.push_back(&node);
+                            continue;
+                        }
+                        _handlers.erase(node);
+                    }
+                    impls[deleted_count++] = impls[i];
+                }
+                removed_count = deleted_count;
+            }
+
+            for (std::size_t i = 0; i < removed_count; ++i)
+                delete &handler_node::get_node(impls[i]);
+        }
+
+        void release_nodes(token::implementation** impls, std::size_t count, shared_emission_tag)
+        {
+            get_lock_primitive().lock_nonrecursive();
+            auto sg = detail::at_scope_exit([&] { get_lock_primitive().unlock_nonrecursive(); } );
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                handler_node& node = handler_node::get_node(impls[i]);
+                if (_handlers.contains(node))
+                {
+                    _handlers.erase(node);
+                    node.release_refs(2); // The refs of the signal and of the token
+                }
+                else
+                    node.release_refs(1);
+            }
+        }
+
+        void release_nodes(token::implementation** impls, std::size_t count, snapshot_emission_tag)
+        {
+            get_lock_primitive().lock_nonrecursive();
+            auto sg = detail::at_scope_exit([&] { get_lock_primitive().unlock_nonrecursive(); } );
+
+            std::size_t contained_count = 0;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                handler_node& node = handler_node::get_node(impls[i]);
+                if (_handlers.contains(node))
+                    impls[contained_count++] = impls[i];
+                else
+                    node.release_refs(1);
+            }
+
+            if (contained_count != 0)
+                _handlers.retire_many(contained_count, [&](std::size_t i) -> handler_node& { return handler_node::get_node(impls[i]); }, 2); // The refs of the signal and of the token
+        }
+
+        template < typename EmissionTag_ >
+        void collect_nodes(EmissionTag_)
+        {
+            if (_emission_state.emitters_count == 0 && WIGWAG_EXPECT(_emission_state.has_garbage(), 0))
+                collect_nodes();
+        }
+
+        void collect_nodes(snapshot_emission_tag)
+        { }
+
+        void collect_nodes()
+        {
+            for (auto n : _emission_state.retired_nodes)
+            {
+                _handlers.erase(*n);
+                delete n;
+            }
+            _emission_state.retired_nodes.clear();
+
+            if (_emission_state.released_count.exchange(0) == 0)
+                return;
+
+            for (auto it = _handlers.begin(); it != _handlers.end();)
+            {
+                handler_node& node = *it++;
+                if (node.should_be_finalized())
+                {
+                    _handlers.erase(node);
+                    node.release_refs(1);
+                }
+            }
+        }
+
+        template < typename EmissionTag_ >
+        void finalize_nodes(EmissionTag_)
+        {
+            if (_emission_state.emitters_count != 0)
+                return;
+
+            collect_nodes();
+            for (auto it = _handlers.begin(); it != _handlers.end();)
+            {
+                handler_node& node = *it++;
+                _handlers.erase(node);
+                node.release_refs(1);
+            }
+        }
+
+        void finalize_nodes(snapshot_emission_tag)
+        { _handlers.retire_all(1); }
+
+        void collect_retired()
+        {
+            get_lock_primitive().lock_nonrecursive();
+            auto sg = detail::at_scope_exit([&] { get_lock_primitive().unlock_nonrecursive(); } );
+            _handlers.collect();
+        }
 
-    protected:
         template < typename... Args_>
         token create_node(handler_attributes attributes, Args_&&... args)
         {
@@ -0,0 +1,140 @@
+#ifndef WIGWAG_DETAIL_MPSC_QUEUE_HPP
+#define WIGWAG_DETAIL_MPSC_QUEUE_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/at_scope_exit.hpp>
+#include <wigwag/policies/allocation/heap.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // A lock-free multi-producer/single-consumer queue. The producers push onto a single atomic list head,
+    // the consumer takes the whole list at once and processes it in FIFO order without touching the head again.
+    template < typename T_, typename AllocationPolicy_ = wigwag::allocation::heap >
+    class mpsc_queue
+    {
+        struct node
+        {
+            node*   next;
+            T_      value;
+
+            template < typename... Args_ >
+            node(Args_&&... args) : next(nullptr), value(std::forward<Args_>(args)...) { }
+
+            static void* operator new(std::size_t size) { return AllocationPolicy_::allocate(size); }
+            static void operator delete(void* p, std::size_t size) { AllocationPolicy_::deallocate(p, size); }
+        };
+
+    private:
+        std::atomic<node*>  _head;
+
+    public:
+        mpsc_queue() : _head(nullptr) { }
+
+        mpsc_queue(const mpsc_queue&) = delete;
+        mpsc_queue& operator = (const mpsc_queue&) = delete;
+
+        ~mpsc_queue()
+        { delete_nodes(_head.load(std::memory_order_acquire)); }
+
+        bool empty() const
+        { return _head.load() == nullptr; }
+
+        void push(T_ value)
+        {
+            node* n = new node(std::move(value));
+            node* head = _head.load(std::memory_order_relaxed);
+            do
+                n->next = head;
+            while (!_head.compare_exchange_weak(head, n, std::memory_order_seq_cst, std::memory_order_relaxed));
+        }
+
+        // Each value is constructed from the moved element and the extra arguments
+        template < typename Iterator_, typename... ExtraArgs_ >
+        void push(Iterator_ begin, Iterator_ end, const ExtraArgs_&... extra_args)
+        {
+            if (begin == end)
+                return;
+
+            node* first = new node(std::move(*begin), extra_args...);
+            node* last = first;
+            auto sg = at_scope_exit([&] { delete_nodes(last); } );
+            for (++begin; begin != end; ++begin)
+            {
+                node* n = new node(std::move(*begin), extra_args...);
+                n->next = last;
+                last = n;
+            }
+
+            node* head = _head.load(std::memory_order_relaxed);
+            do
+                first->next = head;
+            while (!_head.compare_exchange_weak(head, last, std::memory_order_seq_cst, std::memory_order_relaxed));
+            last = nullptr;
+        }
+
+        // Must be called from the consumer thread only
+        template < typename Func_ >
+        std::size_t consume_all(Func_&& func)
+        {
+            node* n = reverse(_head.exchange(nullptr, std::memory_order_acquire));
+            auto sg = at_scope_exit([&] { delete_nodes(n); } );
+
+            std::size_t count = 0;
+            for (; n; ++count)
+            {
+                node* cur = n;
+                n = n->next;
+                auto cur_sg = at_scope_exit([&] { delete cur; } );
+                func(cur->value);
+            }
+            return count;
+        }
+
+    private:
+        static node* reverse(node* n)
+        {
+            node* result = nullptr;
+            while (n)
+            {
+                node* next = n->next;
+                n->next = result;
+                result = n;
+                n = next;
+            }
+            return result;
+        }
+
+        static void delete_nodes(node* n)
+        {
+            while (n)
+            {
+                node* next = n->next;
+                delete n;
+                n = next;
+            }
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
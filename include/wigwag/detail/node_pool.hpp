@@ -0,0 +1,207 @@
+#ifndef WIGWAG_DETAIL_NODE_POOL_HPP
+#define WIGWAG_DETAIL_NODE_POOL_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // A process-wide pool of small blocks, split into size classes. Each thread allocates from and frees to its own cache without locking,
+    // the cache exchanges batches of blocks with the shared lists when it runs dry or grows too large. The memory is never returned to the system.
+    class node_pool
+    {
+        static const std::size_t granularity = 16;
+        static const std::size_t size_classes_count = 16;
+        static const std::size_t batch_size = 64;
+        static const std::size_t max_cached_blocks = 4 * batch_size;
+
+        struct free_block
+        { free_block* next; };
+
+        struct free_list
+        {
+            free_block*     head;
+            std::size_t     count;
+
+            free_list() : head(nullptr), count(0) { }
+
+            void push(free_block* b)
+            {
+                b->next = head;
+                head = b;
+                ++count;
+            }
+
+            free_block* pop()
+            {
+                free_block* b = head;
+                head = b->next;
+                --count;
+                return b;
+            }
+
+            void move_from(free_list& other, std::size_t n)
+            {
+                for (; n != 0 && other.head; --n)
+                    push(other.pop());
+            }
+        };
+
+        class shared_lists
+        {
+        private:
+            std::mutex      _mutex;
+            free_list       _lists[size_classes_count];
+
+        public:
+            shared_lists() : _mutex() { }
+
+            void take(free_list& dst, std::size_t size_class)
+            {
+                {
+                    std::lock_guard<std::mutex> l(_mutex);
+                    dst.move_from(_lists[size_class], batch_size);
+                }
+
+                if (dst.head)
+                    return;
+
+                const std::size_t block_size = (size_class + 1) * granularity;
+                char* chunk = static_cast<char*>(::operator new(block_size * batch_size));
+                for (std::size_t i = 0; i < batch_size; ++i)
+                    dst.push(reinterpret_cast<free_block*>(chunk + i * block_size));
+            }
+
+            void give(free_list& src, std::size_t size_class, std::size_t n)
+            {
+                std::lock_guard<std::mutex> l(_mutex);
+                _lists[size_class].move_from(src, n);
+            }
+        };
+
+        class thread_cache
+        {
+        private:
+            free_list       _lists[size_classes_count];
+
+        public:
+            thread_cache() { get_cache_ptr() = this; }
+
+            ~thread_cache()
+            {
+                for (std::size_t i = 0; i < size_classes_count; ++i)
+                    get_shared_lists().give(_lists[i], i, _lists[i].count);
+                get_cache_ptr() = nullptr;
+                get_cache_finished() = true;
+            }
+
+            thread_cache(const thread_cache&) = delete;
+            thread_cache& operator = (const thread_cache&) = delete;
+
+            free_list& get_list(std::size_t size_class) { return _lists[size_class]; }
+        };
+
+    public:
+        static void* allocate(std::size_t size)
+        {
+            std::size_t size_class = get_size_class(size);
+            if (size_class >= size_classes_count)
+                return ::operator new(size);
+
+            thread_cache* cache = get_thread_cache();
+            if (WIGWAG_EXPECT(!cache, 0))
+            {
+                free_list l;
+                get_shared_lists().take(l, size_class);
+                void* result = l.pop();
+                get_shared_lists().give(l, size_class, l.count);
+                return result;
+            }
+
+            free_list& l = cache->get_list(size_class);
+            if (WIGWAG_EXPECT(!l.head, 0))
+                get_shared_lists().take(l, size_class);
+            return l.pop();
+        }
+
+        static void deallocate(void* p, std::size_t size) WIGWAG_NOEXCEPT
+        {
+            std::size_t size_class = get_size_class(size);
+            if (size_class >= size_classes_count)
+            {
+                ::operator delete(p);
+                return;
+            }
+
+            thread_cache* cache = get_thread_cache();
+            if (WIGWAG_EXPECT(!cache, 0))
+            {
+                free_list l;
+                l.push(static_cast<free_block*>(p));
+                get_shared_lists().give(l, size_class, 1);
+                return;
+            }
+
+            free_list& l = cache->get_list(size_class);
+            l.push(static_cast<free_block*>(p));
+            if (WIGWAG_EXPECT(l.count > max_cached_blocks, 0))
+                get_shared_lists().give(l, size_class, batch_size);
+        }
+
+    private:
+        static std::size_t get_size_class(std::size_t size)
+        { return size == 0 ? 0 : (size - 1) / granularity; }
+
+        static thread_cache* get_thread_cache()
+        {
+            thread_cache* cache = get_cache_ptr();
+            if (WIGWAG_EXPECT(cache != nullptr, 1) || get_cache_finished())
+                return cache;
+
+            static thread_local thread_cache instance;
+            return &instance;
+        }
+
+        // Trivially destructible, so these stay valid while the thread-local destructors run
+        static thread_cache*& get_cache_ptr()
+        {
+            static thread_local thread_cache* cache_ptr = nullptr;
+            return cache_ptr;
+        }
+
+        static bool& get_cache_finished()
+        {
+            static thread_local bool finished = false;
+            return finished;
+        }
+
+        static shared_lists& get_shared_lists()
+        {
+            static shared_lists* instance = new shared_lists; // Never destroyed, the blocks may be freed by the static destructors
+            return *instance;
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
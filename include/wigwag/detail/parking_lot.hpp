@@ -0,0 +1,124 @@
+#ifndef WIGWAG_DETAIL_PARKING_LOT_HPP
+#define WIGWAG_DETAIL_PARKING_LOT_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Lets a thread wait on an arbitrary address. The waiters are kept in a small process-wide hash table, each of them has its own condition
+    // variable, so unpark_all wakes only the threads that wait on the given address. The buckets are never destroyed.
+    class parking_lot
+    {
+        static const std::size_t buckets_count = 64;
+
+        struct waiter
+        {
+            const void*                 key;
+            std::condition_variable     cond_var;
+            bool                        unparked;
+            waiter*                     next;
+
+            waiter(const void* k) : key(k), cond_var(), unparked(false), next(nullptr) { }
+        };
+
+        struct bucket
+        {
+            std::mutex      mutex;
+            waiter*         head;
+            char            padding[64];
+
+            bucket() : mutex(), head(nullptr) { }
+        };
+
+    public:
+        // The waits are usually short, so spinning for a while is cheaper than parking and being woken up
+        template < typename IsDoneFunc_ >
+        static bool spin(int spin_count, const IsDoneFunc_& is_done)
+        {
+            for (int i = 0; i < spin_count; ++i)
+            {
+                if (is_done())
+                    return true;
+                std::this_thread::yield();
+            }
+            return is_done();
+        }
+
+        // Blocks until unpark_all(key) if should_park() returns true. should_park() is called under the bucket lock, so an unpark_all that
+        // follows a state change cannot be missed.
+        template < typename ShouldParkFunc_ >
+        static void park(const void* key, const ShouldParkFunc_& should_park)
+        {
+            bucket& b = get_bucket(key);
+            std::unique_lock<std::mutex> l(b.mutex);
+            if (!should_park())
+                return;
+
+            waiter w(key);
+            w.next = b.head;
+            b.head = &w;
+            while (!w.unparked)
+                w.cond_var.wait(l);
+        }
+
+        static void unpark_all(const void* key)
+        {
+            bucket& b = get_bucket(key);
+            std::lock_guard<std::mutex> l(b.mutex);
+            for (waiter** w = &b.head; *w;)
+            {
+                waiter* cur = *w;
+                if (cur->key != key)
+                {
+                    w = &cur->next;
+                    continue;
+                }
+
+                *w = cur->next;
+                cur->unparked = true;
+                cur->cond_var.notify_one(); // Under the lock, the waiter is destroyed as soon as it sees the flag
+            }
+        }
+
+    private:
+        static bucket& get_bucket(const void* key)
+        {
+            std::uintptr_t h = reinterpret_cast<std::uintptr_t>(key);
+            h ^= h >> 17;
+            h *= 0x9E3779B1u;
+            return get_buckets()[(h >> 7) % buckets_count];
+        }
+
+        static bucket* get_buckets()
+        {
+            static bucket* instance = new bucket[buckets_count]; // Never destroyed, the tokens may be released by the static destructors
+            return instance;
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
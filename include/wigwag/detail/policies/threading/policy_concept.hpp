@@ -15,6 +15,8 @@
 #include <wigwag/detail/type_expression_check.hpp>
 #include <wigwag/policies/threading/tag.hpp>
 
+#include <utility>
+
 
 namespace wigwag {
 namespace detail {
@@ -34,6 +36,30 @@ namespace threading
         using adapted_policy = typename wigwag::detail::policy_version_detector<check_policy_v2_0<T_>>::adapted_policy;
     };
 
+
+    template < template <typename, typename> class SnapshotContainer_ >
+    struct snapshot_container_enabler
+    { using type = void; };
+
+    template < typename T_, typename Enabler_ = void >
+    struct has_snapshot_container
+    { static const bool value = false; };
+
+    template < typename T_ >
+    struct has_snapshot_container<T_, typename snapshot_container_enabler<T_::template snapshot_container>::type>
+    { static const bool value = true; };
+
+    WIGWAG_DECLARE_TYPE_EXPRESSION_CHECK(has_lock_shared, std::declval<const typename T_::lock_primitive&>().lock_shared());
+
+
+    template < typename T_, typename Node_, typename Storage_, bool HasSnapshotContainer_ = has_snapshot_container<T_>::value >
+    struct handlers_container_picker
+    { using type = Storage_; };
+
+    template < typename T_, typename Node_, typename Storage_ >
+    struct handlers_container_picker<T_, Node_, Storage_, true>
+    { using type = typename T_::template snapshot_container<Node_, Storage_>; };
+
 #include <wigwag/detail/enable_warnings.hpp>
 
 }}}
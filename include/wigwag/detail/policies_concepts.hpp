@@ -11,8 +11,11 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <wigwag/detail/policies/allocation/policy_concept.hpp>
 #include <wigwag/detail/policies/creation/policy_concept.hpp>
 #include <wigwag/detail/policies/exception_handling/policy_concept.hpp>
+#include <wigwag/detail/policies/handler_function/policy_concept.hpp>
+#include <wigwag/detail/policies/handlers_storage/policy_concept.hpp>
 #include <wigwag/detail/policies/life_assurance/policy_concept.hpp>
 #include <wigwag/detail/policies/ref_counter/policy_concept.hpp>
 #include <wigwag/detail/policies/state_populating/policy_concept.hpp>
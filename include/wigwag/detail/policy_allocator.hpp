@@ -0,0 +1,57 @@
+#ifndef WIGWAG_DETAIL_POLICY_ALLOCATOR_HPP
+#define WIGWAG_DETAIL_POLICY_ALLOCATOR_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+
+#include <cstddef>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // A standard allocator on top of an allocation policy
+    template < typename T_, typename AllocationPolicy_ >
+    struct policy_allocator
+    {
+        using value_type = T_;
+
+        policy_allocator() WIGWAG_NOEXCEPT { }
+
+        template < typename U_ >
+        policy_allocator(const policy_allocator<U_, AllocationPolicy_>&) WIGWAG_NOEXCEPT { }
+
+        template < typename U_ >
+        struct rebind
+        { using other = policy_allocator<U_, AllocationPolicy_>; };
+
+        T_* allocate(std::size_t n)
+        { return static_cast<T_*>(AllocationPolicy_::allocate(n * sizeof(T_))); }
+
+        void deallocate(T_* p, std::size_t n) WIGWAG_NOEXCEPT
+        { AllocationPolicy_::deallocate(p, n * sizeof(T_)); }
+
+        template < typename U_ >
+        bool operator == (const policy_allocator<U_, AllocationPolicy_>&) const WIGWAG_NOEXCEPT { return true; }
+
+        template < typename U_ >
+        bool operator != (const policy_allocator<U_, AllocationPolicy_>&) const WIGWAG_NOEXCEPT { return false; }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
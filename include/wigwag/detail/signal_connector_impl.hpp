@@ -15,6 +15,10 @@
 #include <wigwag/task_executor.hpp>
 #include <wigwag/token.hpp>
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 
 namespace wigwag {
 namespace detail
@@ -29,6 +33,8 @@ namespace detail
 
         virtual token connect(std::function<Signature_> handler, handler_attributes attributes) = 0;
         virtual token connect(std::shared_ptr<task_executor> worker, std::function<Signature_> handler, handler_attributes attributes) = 0;
+        virtual std::vector<token> connect_many(std::vector<std::function<Signature_>> handlers, handler_attributes attributes) = 0;
+        virtual std::vector<token> connect_many(std::shared_ptr<task_executor> worker, std::vector<std::function<Signature_>> handlers, handler_attributes attributes) = 0;
 
         virtual void add_ref() = 0;
         virtual void release() = 0;
@@ -12,10 +12,15 @@
 
 
 #include <wigwag/detail/async_handler.hpp>
+#include <wigwag/detail/async_tasks_batch.hpp>
 #include <wigwag/detail/listenable_impl.hpp>
 #include <wigwag/detail/signal_connector_impl.hpp>
 #include <wigwag/signal_attributes.hpp>
 
+#include <atomic>
+#include <iterator>
+#include <vector>
+
 
 namespace wigwag {
 namespace detail
@@ -29,27 +34,33 @@ namespace detail
             typename ThreadingPolicy_,
             typename StatePopulatingPolicy_,
             typename LifeAssurancePolicy_,
-            typename RefCounterPolicy_
+            typename RefCounterPolicy_,
+            typename HandlersStoragePolicy_,
+            typename HandlerFunctionPolicy_,
+            typename AllocationPolicy_
         >
     class signal_impl
         :   public signal_connector_impl<Signature_>,
-            private listenable_impl<std::function<Signature_>, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_>
+            private listenable_impl<typename HandlerFunctionPolicy_::template function<Signature_>, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_, HandlersStoragePolicy_, AllocationPolicy_>
     {
     WIGWAG_PRIVATE_IS_CONSTRUCTIBLE_WORKAROUND:
-        using listenable_base = listenable_impl<std::function<Signature_>, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_>;
+        using listenable_base = listenable_impl<typename HandlerFunctionPolicy_::template function<Signature_>, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_, HandlersStoragePolicy_, AllocationPolicy_>;
 
     private:
-        using handler_type = std::function<Signature_>;
+        using handler_type = typename HandlerFunctionPolicy_::template function<Signature_>;
 
         using handler_node = typename listenable_base::handler_node;
         using lock_primitive = typename listenable_base::lock_primitive;
         using life_checker = typename listenable_base::life_checker;
         using execution_guard = typename listenable_base::execution_guard;
 
+    private:
+        std::atomic<bool>       _has_async_handlers;
+
     public:
         template < typename... Args_, bool E_ = std::is_constructible<listenable_base, Args_...>::value, typename = typename std::enable_if<E_>::type >
         signal_impl(Args_&&... args)
-            : listenable_base(std::forward<Args_>(args)...)
+            : listenable_base(std::forward<Args_>(args)...), _has_async_handlers(false)
         { }
 
         void finalize_nodes()
@@ -61,15 +72,19 @@ namespace detail
         virtual void add_ref() { listenable_base::add_ref(); }
         virtual void release() { listenable_base::release(); }
 
-        virtual token connect(handler_type handler, handler_attributes attributes)
+        virtual token connect(std::function<Signature_> handler, handler_attributes attributes)
+        { return connect_handler(std::move(handler), attributes); }
+
+        template < typename HandlerFunc_ >
+        token connect_handler(HandlerFunc_ handler, handler_attributes attributes)
         {
             if (contains_flag(this->get_attributes(), signal_attributes::connect_async_only))
                 WIGWAG_THROW("The signal restrains connecting synchronous handlers!");
 
-            return listenable_base::connect(std::move(handler), attributes);
+            return listenable_base::connect(handler_type(std::move(handler)), attributes);
         }
 
-        virtual token connect(std::shared_ptr<task_executor> worker, handler_type handler, handler_attributes attributes)
+        virtual token connect(std::shared_ptr<task_executor> worker, std::function<Signature_> handler, handler_attributes attributes)
         {
             if (contains_flag(this->get_attributes(), signal_attributes::connect_sync_only))
                 WIGWAG_THROW("The signal restrains connecting asynchronous handlers!");
@@ -77,45 +92,73 @@ namespace detail
             this->get_lock_primitive().lock_nonrecursive();
             auto sg = detail::at_scope_exit([&] { this->get_lock_primitive().unlock_nonrecursive(); } );
 
-            return this->create_node(attributes,
-                    [&](life_checker lc) {
-                        async_handler<Signature_, LifeAssurancePolicy_> real_handler(std::move(worker), std::move(lc), std::move(handler));
-                        if (!contains_flag(attributes, handler_attributes::suppress_populator) && this->get_handler_processor().has_populate_state())
-                            this->get_exception_handler().handle_exceptions([&] { this->get_handler_processor().populate_state(real_handler); });
-                        return real_handler;
-                    });
+            return this->create_node(attributes, [&](life_checker lc) { return this->make_async_handler(std::move(worker), std::move(lc), std::move(handler), attributes); });
         }
 
-        template < typename... Args_ >
-        void invoke(Args_&&... args)
+        virtual std::vector<token> connect_many(std::vector<std::function<Signature_>> handlers, handler_attributes attributes)
+        { return connect_many_handlers(std::make_move_iterator(handlers.begin()), std::make_move_iterator(handlers.end()), attributes); }
+
+        virtual std::vector<token> connect_many(std::shared_ptr<task_executor> worker, std::vector<std::function<Signature_>> handlers, handler_attributes attributes)
+        { return connect_many_handlers(std::move(worker), std::make_move_iterator(handlers.begin()), std::make_move_iterator(handlers.end()), attributes); }
+
+        template < typename Iterator_ >
+        std::vector<token> connect_many_handlers(Iterator_ begin, Iterator_ end, handler_attributes attributes)
         {
-            this->get_lock_primitive().lock_recursive();
-            auto sg = detail::at_scope_exit([&] { this->get_lock_primitive().unlock_recursive(); } );
+            if (contains_flag(this->get_attributes(), signal_attributes::connect_async_only))
+                WIGWAG_THROW("The signal restrains connecting synchronous handlers!");
 
-            if (this->_handlers.empty())
-                return;
-            auto it = this->_handlers.begin(), e = this->_handlers.pre_end();
+            return listenable_base::connect_many(begin, end, attributes);
+        }
+
+        template < typename Iterator_ >
+        std::vector<token> connect_many_handlers(std::shared_ptr<task_executor> worker, Iterator_ begin, Iterator_ end, handler_attributes attributes)
+        {
+            if (contains_flag(this->get_attributes(), signal_attributes::connect_sync_only))
+                WIGWAG_THROW("The signal restrains connecting asynchronous handlers!");
+
+            std::vector<token> tokens;
+            listenable_base::reserve_tokens(tokens, begin, end, typename std::iterator_traits<Iterator_>::iterator_category());
 
-            bool last_iter = false;
-            while (!last_iter)
+            this->get_lock_primitive().lock_nonrecursive();
+            auto sg = detail::at_scope_exit([&] { this->get_lock_primitive().unlock_nonrecursive(); } );
+
+            for (; begin != end; ++begin)
+                tokens.push_back(this->create_node(attributes, [&](life_checker lc) { return this->make_async_handler(worker, std::move(lc), std::function<Signature_>(*begin), attributes); }));
+
+            return tokens;
+        }
+
+        // The batch and the payload are needed by the asynchronous handlers only. Missing the flag is harmless, the tasks are just posted one by one then
+        template < typename... Args_ >
+        void invoke(Args_&&... args)
+        {
+            if (WIGWAG_EXPECT(!_has_async_handlers.load(std::memory_order_relaxed), 1))
             {
-                last_iter = it == e;
-
-                if (it->should_be_finalized())
-                {
-                    (it++)->finalize_node();
-                    continue;
-                }
-
-                execution_guard g(listenable_base::get_life_assurance_shared_data(), it->get_life_assurance());
-                if (g.is_alive())
-                    this->get_exception_handler().handle_exceptions(it->get_handler(), std::forward<Args_>(args)...);
-                ++it;
+                listenable_base::invoke([&](handler_type& handler) { handler(std::forward<Args_>(args)...); });
+                return;
             }
+
+            async_tasks_batch batch;
+            async_payload<Signature_, AllocationPolicy_> payload;
+            listenable_base::invoke([&](handler_type& handler) { handler(std::forward<Args_>(args)...); });
+            batch.flush();
         }
 
     protected:
         virtual signal_attributes get_attributes() const { return signal_attributes::none; }
+
+    private:
+        async_handler<Signature_, LifeAssurancePolicy_, AllocationPolicy_> make_async_handler(std::shared_ptr<task_executor> worker, life_checker lc, std::function<Signature_> handler, handler_attributes attributes)
+        {
+            _has_async_handlers.store(true, std::memory_order_relaxed);
+            async_handler<Signature_, LifeAssurancePolicy_, AllocationPolicy_> real_handler(std::move(worker), std::move(lc), std::move(handler), contains_flag(attributes, handler_attributes::conflate));
+            if (!contains_flag(attributes, handler_attributes::suppress_populator) && this->get_handler_processor().has_populate_state())
+            {
+                async_payload<Signature_, AllocationPolicy_> payload;
+                this->get_exception_handler().handle_exceptions([&] { this->get_handler_processor().populate_state(real_handler); });
+            }
+            return real_handler;
+        }
     };
 
 
@@ -125,12 +168,15 @@ namespace detail
             typename ThreadingPolicy_,
             typename StatePopulatingPolicy_,
             typename LifeAssurancePolicy_,
-            typename RefCounterPolicy_
+            typename RefCounterPolicy_,
+            typename HandlersStoragePolicy_,
+            typename HandlerFunctionPolicy_,
+            typename AllocationPolicy_
         >
-    class signal_with_attributes_impl : public signal_impl<Signature_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_>
+    class signal_with_attributes_impl : public signal_impl<Signature_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_, HandlersStoragePolicy_, HandlerFunctionPolicy_, AllocationPolicy_>
     {
     WIGWAG_PRIVATE_IS_CONSTRUCTIBLE_WORKAROUND:
-        using base = signal_impl<Signature_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_>;
+        using base = signal_impl<Signature_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_, HandlersStoragePolicy_, HandlerFunctionPolicy_, AllocationPolicy_>;
 
     private:
         signal_attributes   _attributes;
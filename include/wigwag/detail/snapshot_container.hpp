@@ -0,0 +1,208 @@
+#ifndef WIGWAG_DETAIL_SNAPSHOT_CONTAINER_HPP
+#define WIGWAG_DETAIL_SNAPSHOT_CONTAINER_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#include <wigwag/detail/at_scope_exit.hpp>
+
+
+#include <wigwag/detail/config.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Keeps the nodes in Storage_ and publishes an immutable array of pointers to them after each modification, so that the readers do not need any locks.
+    // The readers register in one of the two counters selected by the current epoch. The retired snapshots and nodes are reclaimed once the readers
+    // that might have seen them are gone: the epoch is flipped only when nobody reads in the other one, and the retired objects are freed when the
+    // readers of the epoch they were retired in leave. All the non-const methods must be called under the writers lock.
+    template < typename T_, typename Storage_ >
+    class snapshot_container
+    {
+    public:
+        using snapshot = std::vector<T_*>;
+
+    private:
+        struct retired_node
+        {
+            T_*     node;
+            int     refs;
+
+            retired_node(T_* n, int r) : node(n), refs(r) { }
+        };
+
+        Storage_                            _storage;
+        std::atomic<const snapshot*>        _snapshot;
+        std::atomic<unsigned>               _epoch;
+        mutable std::atomic<int>            _readers[2];
+        std::atomic<bool>                   _has_retired;
+        bool                                _publishing_deferred;
+        std::vector<const snapshot*>        _retired_snapshots[2];
+        std::vector<retired_node>           _retired_nodes[2];
+
+    public:
+        snapshot_container()
+            : _snapshot(nullptr), _epoch(0), _has_retired(false), _publishing_deferred(false)
+        {
+            _readers[0] = 0;
+            _readers[1] = 0;
+        }
+
+        ~snapshot_container()
+        {
+            WIGWAG_ASSERT(_readers[0] == 0 && _readers[1] == 0, "Internal wigwag error, the container is destroyed while being read!");
+            reclaim(0);
+            reclaim(1);
+            delete _snapshot.load();
+        }
+
+        snapshot_container(const snapshot_container&) = delete;
+        snapshot_container& operator = (const snapshot_container&) = delete;
+
+        typename Storage_::iterator begin() { return _storage.begin(); }
+        typename Storage_::iterator end() { return _storage.end(); }
+
+        bool empty() const { return _storage.empty(); }
+        size_t size() const { return _storage.size(); }
+        bool contains(const T_& node) const { return _storage.contains(node); }
+
+        void push_back(T_& node)
+        {
+            _storage.push_back(node);
+            if (_publishing_deferred)
+                return;
+            publish();
+            collect();
+        }
+
+        // Calls push_nodes, that may push_back any number of nodes, and publishes a single snapshot for all of them
+        template < typename PushNodesFunc_ >
+        void push_many(const PushNodesFunc_& push_nodes)
+        {
+            _publishing_deferred = true;
+            auto sg = at_scope_exit([&]
+                {
+                    _publishing_deferred = false;
+                    publish();
+                    collect();
+                } );
+            push_nodes();
+        }
+
+        // Retires the nodes get_node(0) ... get_node(count - 1) and publishes a single snapshot for all of them
+        template < typename GetNodeFunc_ >
+        void retire_many(std::size_t count, const GetNodeFunc_& get_node, int refs)
+        {
+            std::vector<retired_node>& retired_nodes = _retired_nodes[_epoch & 1];
+            retired_nodes.reserve(retired_nodes.size() + count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                T_& node = get_node(i);
+                _storage.erase(node);
+                retired_nodes.push_back(retired_node(&node, refs));
+            }
+            publish();
+            _has_retired = true;
+            collect();
+        }
+
+        void retire_all(int refs)
+        {
+            std::vector<retired_node>& retired_nodes = _retired_nodes[_epoch & 1];
+            while (!_storage.empty())
+            {
+                T_& node = *_storage.begin();
+                _storage.erase(node);
+                retired_nodes.push_back(retired_node(&node, refs));
+            }
+            publish();
+            _has_retired = true;
+            collect();
+        }
+
+        void collect()
+        {
+            if (!_has_retired)
+                return;
+
+            unsigned cur = _epoch & 1, prev = cur ^ 1;
+            if (_readers[prev] == 0)
+            {
+                reclaim(prev);
+                if (!_retired_snapshots[cur].empty() || !_retired_nodes[cur].empty())
+                {
+                    _epoch = prev;
+                    if (_readers[cur] == 0)
+                        reclaim(cur);
+                }
+            }
+
+            _has_retired = !_retired_snapshots[0].empty() || !_retired_nodes[0].empty() || !_retired_snapshots[1].empty() || !_retired_nodes[1].empty();
+        }
+
+        unsigned lock_snapshot() const
+        {
+            unsigned epoch = _epoch & 1;
+            ++_readers[epoch];
+            return epoch;
+        }
+
+        bool unlock_snapshot(unsigned epoch) const
+        { return --_readers[epoch] == 0 && _has_retired; }
+
+        const snapshot* get_snapshot() const
+        { return _snapshot; }
+
+    private:
+        void publish()
+        {
+            snapshot* s = nullptr;
+            if (!_storage.empty())
+            {
+                s = new snapshot;
+                s->reserve(_storage.size());
+                for (auto it = _storage.begin(); it != _storage.end(); ++it)
+                    s->push_back(&*it);
+            }
+
+            const snapshot* old = _snapshot.exchange(s);
+            if (old)
+            {
+                _retired_snapshots[_epoch & 1].push_back(old);
+                _has_retired = true;
+            }
+        }
+
+        void reclaim(unsigned epoch)
+        {
+            std::vector<const snapshot*> snapshots;
+            std::vector<retired_node> nodes;
+            snapshots.swap(_retired_snapshots[epoch]);
+            nodes.swap(_retired_nodes[epoch]);
+
+            for (auto s : snapshots)
+                delete s;
+            for (const auto& n : nodes)
+                n.node->release_refs(n.refs);
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef WIGWAG_DETAIL_TASK_QUEUE_LIMITER_HPP
+#define WIGWAG_DETAIL_TASK_QUEUE_LIMITER_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/at_scope_exit.hpp>
+#include <wigwag/detail/config.hpp>
+#include <wigwag/overflow_policy.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Counts the queued tasks of an executor and applies the overflow policy. With drop_oldest the queue may hold more tasks than
+    // its capacity for a while: the excess is remembered and the consumer drops that many tasks before executing anything.
+    // The capacity should be set before the executor is used by other threads.
+    class task_queue_limiter
+    {
+    public:
+        static const std::size_t unbounded = std::numeric_limits<std::size_t>::max();
+
+    private:
+        std::size_t                 _capacity;
+        overflow_policy             _policy;
+        std::atomic<std::size_t>    _size;
+        std::atomic<std::size_t>    _excess;
+        std::atomic<std::size_t>    _dropped_count;
+        std::atomic<std::size_t>    _blocked_count;
+        std::atomic<int>            _waiting_producers;
+        std::mutex                  _mutex;
+        std::condition_variable     _cv;
+
+    public:
+        task_queue_limiter()
+            : _capacity(unbounded), _policy(overflow_policy::block), _size(0), _excess(0), _dropped_count(0), _blocked_count(0), _waiting_producers(0), _mutex(), _cv()
+        { }
+
+        task_queue_limiter(const task_queue_limiter&) = delete;
+        task_queue_limiter& operator = (const task_queue_limiter&) = delete;
+
+        void set_capacity(std::size_t capacity, overflow_policy policy)
+        {
+            if (capacity == 0)
+                WIGWAG_THROW("The capacity of a task queue should be positive!");
+
+            _capacity = capacity;
+            _policy = policy;
+        }
+
+        bool is_bounded() const { return _capacity != unbounded; }
+
+        std::size_t get_dropped_count() const { return _dropped_count.load(std::memory_order_relaxed); }
+        std::size_t get_blocked_count() const { return _blocked_count.load(std::memory_order_relaxed); }
+
+        // Takes a place for a new task, returns false if the task should be dropped
+        bool acquire()
+        {
+            switch (_policy)
+            {
+            case overflow_policy::block:
+                if (!try_acquire())
+                    wait_and_acquire();
+                return true;
+            case overflow_policy::drop_oldest:
+                if (++_size > _capacity)
+                {
+                    ++_excess;
+                    _dropped_count.fetch_add(1, std::memory_order_relaxed);
+                }
+                return true;
+            case overflow_policy::drop_newest:
+                if (try_acquire())
+                    return true;
+                _dropped_count.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            case overflow_policy::fail:
+                if (try_acquire())
+                    return true;
+                _dropped_count.fetch_add(1, std::memory_order_relaxed);
+                WIGWAG_THROW("The task queue is full!");
+            }
+            return false;
+        }
+
+        // Adds the items one by one. If add_func throws, the item it was given and the ones after it are counted as dropped
+        template < typename T_, typename AddFunc_ >
+        void add_each(T_* items, std::size_t count, const AddFunc_& add_func)
+        {
+            std::size_t i = 0;
+            auto sg = at_scope_exit([&] { if (i < count) _dropped_count.fetch_add(count - i - 1, std::memory_order_relaxed); } );
+
+            for (; i < count; ++i)
+                add_func(std::move(items[i]));
+        }
+
+        // Takes one of the tasks that are to be dropped if there are more than reserved_count of them, returns false otherwise
+        bool take_excess(std::size_t reserved_count = 0)
+        {
+            std::size_t excess = _excess.load();
+            while (excess > reserved_count)
+                if (_excess.compare_exchange_weak(excess, excess - 1))
+                    return true;
+            return false;
+        }
+
+        // Frees the place of a task that leaves the queue
+        void release()
+        {
+            --_size;
+            if (_waiting_producers != 0)
+            {
+                std::lock_guard<std::mutex> l(_mutex);
+                _cv.notify_all();
+            }
+        }
+
+        // Called by the consumer for every dequeued task, returns true if the task should be dropped instead of being executed
+        bool release_dequeued()
+        {
+            bool drop = take_excess();
+            release();
+            return drop;
+        }
+
+    private:
+        bool try_acquire()
+        {
+            std::size_t size = _size.load();
+            while (size < _capacity)
+                if (_size.compare_exchange_weak(size, size + 1))
+                    return true;
+            return false;
+        }
+
+        // A producer is counted as waiting before it checks the size for the last time, so either it sees the freed place or release() sees it waiting
+        void wait_and_acquire()
+        {
+            _blocked_count.fetch_add(1, std::memory_order_relaxed);
+
+            std::unique_lock<std::mutex> l(_mutex);
+            ++_waiting_producers;
+            auto sg = at_scope_exit([&] { --_waiting_producers; } );
+
+            while (!try_acquire())
+                _cv.wait(l);
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
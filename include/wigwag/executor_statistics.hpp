@@ -0,0 +1,79 @@
+#ifndef WIGWAG_EXECUTOR_STATISTICS_HPP
+#define WIGWAG_EXECUTOR_STATISTICS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace wigwag
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // A snapshot of the executor counters since the statistics were enabled
+    struct executor_statistics
+    {
+        // The bucket i counts the durations in [2^i, 2^(i + 1)) nanoseconds, the last one counts all the longer ones too
+        static const std::size_t histogram_size = 32;
+        using histogram = std::array<std::uint64_t, histogram_size>;
+
+        std::size_t                 queue_depth;
+        std::size_t                 max_queue_depth;
+        std::uint64_t               tasks_count;
+        std::uint64_t               dropped_tasks_count;
+        std::chrono::nanoseconds    elapsed_time;
+        std::chrono::nanoseconds    busy_time;
+        histogram                   wait_times;     // From add_task to the start of the execution
+        histogram                   run_times;
+
+        executor_statistics()
+            : queue_depth(0), max_queue_depth(0), tasks_count(0), dropped_tasks_count(0), elapsed_time(0), busy_time(0), wait_times(), run_times()
+        {
+            wait_times.fill(0);
+            run_times.fill(0);
+        }
+
+        double get_tasks_per_second() const
+        { return elapsed_time.count() > 0 ? tasks_count * 1e9 / elapsed_time.count() : 0.0; }
+
+        // The busy time of a thread_pool_task_executor is summed over its workers, so the ratio may exceed one there
+        double get_busy_ratio() const
+        { return elapsed_time.count() > 0 ? double(busy_time.count()) / elapsed_time.count() : 0.0; }
+
+        // Returns the upper bound of the bucket that contains the given percentile, e.g. get_percentile(wait_times, 0.99)
+        static std::chrono::nanoseconds get_percentile(const histogram& h, double percentile)
+        {
+            std::uint64_t total = 0;
+            for (auto n : h)
+                total += n;
+            if (total == 0)
+                return std::chrono::nanoseconds(0);
+
+            std::uint64_t threshold = static_cast<std::uint64_t>(percentile * total), count = 0;
+            for (std::size_t i = 0; i < histogram_size; ++i)
+            {
+                count += h[i];
+                if (count > threshold || count == total)
+                    return std::chrono::nanoseconds(std::int64_t(2) << i);
+            }
+            return std::chrono::nanoseconds(std::int64_t(2) << (histogram_size - 1));
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}
+
+#endif
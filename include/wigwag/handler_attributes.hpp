@@ -22,7 +22,8 @@ namespace wigwag
     enum class handler_attributes
     {
         none                    = 0x0,
-        suppress_populator      = 0x1
+        suppress_populator      = 0x1,
+        conflate                = 0x2   // An asynchronous handler keeps at most one pending task, it is invoked with the latest arguments
     };
 
     WIGWAG_DECLARE_ENUM_BITWISE_OPERATORS(handler_attributes)
@@ -13,9 +13,9 @@
 
 #include <wigwag/detail/annotations.hpp>
 #include <wigwag/detail/config.hpp>
+#include <wigwag/detail/parking_lot.hpp>
 
 #include <atomic>
-#include <condition_variable>
 #include <limits>
 #include <memory>
 
@@ -30,12 +30,11 @@ namespace wigwag
     private:
         using int_type = unsigned int;
         static const int_type alive_flag = ((int_type)1) << (std::numeric_limits<int_type>::digits - 1);
+        static const int_type waiting_flag = alive_flag >> 1;
 
         struct impl
         {
             std::atomic<int_type>       lock_counter_and_alive_flag;
-            std::condition_variable     cond_var;
-            std::mutex                  mutex;
 
             impl() : lock_counter_and_alive_flag(alive_flag) { }
         };
@@ -45,17 +44,25 @@ namespace wigwag
         class checker;
         class execution_guard;
 
+        static const int default_spin_count = 64;
+
     private:
         impl_ptr        _impl;
+        int             _spin_count;
         bool            _released;
 
     public:
         life_token()
-            : _impl(std::make_shared<impl>()), _released(false)
+            : _impl(std::make_shared<impl>()), _spin_count(default_spin_count), _released(false)
+        { }
+
+        // spin_count is the number of times release() yields before parking the thread
+        explicit life_token(int spin_count)
+            : _impl(std::make_shared<impl>()), _spin_count(spin_count), _released(false)
         { }
 
         life_token(life_token&& other) WIGWAG_NOEXCEPT
-            : _impl(other._impl), _released(false)
+            : _impl(other._impl), _spin_count(other._spin_count), _released(false)
         { other._released = true; }
 
         ~life_token()
@@ -66,12 +73,16 @@ namespace wigwag
             if (_released)
                 return;
 
-            _impl->lock_counter_and_alive_flag -= alive_flag;
-            std::unique_lock<std::mutex> l(_impl->mutex);
-            while (_impl->lock_counter_and_alive_flag != 0)
-                _impl->cond_var.wait(l);
-
             _released = true;
+
+            std::atomic<int_type>& counter = _impl->lock_counter_and_alive_flag;
+            counter -= alive_flag;
+            if (detail::parking_lot::spin(_spin_count, [&] { return counter == 0; }))
+                return;
+
+            counter |= waiting_flag;
+            while (counter != waiting_flag)
+                detail::parking_lot::park(&counter, [&] { return counter != waiting_flag; });
         }
 
         life_token(const life_token&) = delete;
@@ -127,13 +138,13 @@ namespace wigwag
         void unlock()
         {
             int_type i = --_impl->lock_counter_and_alive_flag;
-            if (i == 0)
+            if (i == 0 || i == waiting_flag)
             {
                 WIGWAG_ANNOTATE_HAPPENS_AFTER(&_impl->lock_counter_and_alive_flag);
                 WIGWAG_ANNOTATE_RELEASE(&_impl->lock_counter_and_alive_flag);
 
-                std::unique_lock<std::mutex> l(_impl->mutex);
-                _impl->cond_var.notify_all();
+                if (i == waiting_flag)
+                    detail::parking_lot::unpark_all(&_impl->lock_counter_and_alive_flag);
             }
             else
                 WIGWAG_ANNOTATE_HAPPENS_BEFORE(&_impl->lock_counter_and_alive_flag);
@@ -15,8 +15,11 @@
 #include <wigwag/detail/listenable_impl.hpp>
 #include <wigwag/detail/policies_concepts.hpp>
 #include <wigwag/detail/policy_picker.hpp>
+#include <wigwag/multi_token.hpp>
 #include <wigwag/policies.hpp>
 
+#include <iterator>
+
 
 namespace wigwag
 {
@@ -31,7 +34,9 @@ namespace wigwag
                 policies_config_entry<state_populating::policy_concept, wigwag::state_populating::default_>,
                 policies_config_entry<life_assurance::policy_concept, wigwag::life_assurance::default_>,
                 policies_config_entry<creation::policy_concept, wigwag::creation::default_>,
-                policies_config_entry<ref_counter::policy_concept, wigwag::ref_counter::default_>
+                policies_config_entry<ref_counter::policy_concept, wigwag::ref_counter::default_>,
+                policies_config_entry<handlers_storage::policy_concept, wigwag::handlers_storage::default_>,
+                policies_config_entry<allocation::policy_concept, wigwag::allocation::default_>
             >;
     }
 
@@ -52,12 +57,14 @@ namespace wigwag
         using life_assurance_policy = policy<detail::life_assurance::policy_concept>;
         using creation_policy = policy<detail::creation::policy_concept>;
         using ref_counter_policy = policy<detail::ref_counter::policy_concept>;
+        using handlers_storage_policy = policy<detail::handlers_storage::policy_concept>;
+        using allocation_policy = policy<detail::allocation::policy_concept>;
 
     public:
         using listener_type = ListenerType_;
 
     WIGWAG_PRIVATE_IS_CONSTRUCTIBLE_WORKAROUND:
-        using impl_type = detail::listenable_impl<ListenerType_, exception_handling_policy, threading_policy, state_populating_policy, life_assurance_policy, ref_counter_policy>;
+        using impl_type = detail::listenable_impl<ListenerType_, exception_handling_policy, threading_policy, state_populating_policy, life_assurance_policy, ref_counter_policy, handlers_storage_policy, allocation_policy>;
         using impl_type_ptr = detail::intrusive_ptr<impl_type>;
 
     private:
@@ -95,6 +102,10 @@ namespace wigwag
         token connect(ListenerType_ handler, handler_attributes attributes = handler_attributes::none) const
         { return _impl->connect(std::move(handler), attributes); }
 
+        template < typename ListenersRange_ >
+        multi_token connect_many(const ListenersRange_& handlers, handler_attributes attributes = handler_attributes::none) const
+        { return multi_token(_impl->connect_many(std::begin(handlers), std::end(handlers), attributes)); }
+
         template < typename InvokeListenerFunc_ >
         void invoke(InvokeListenerFunc_&& invoke_listener_func) const
         {
@@ -0,0 +1,103 @@
+#ifndef WIGWAG_MULTI_TOKEN_HPP
+#define WIGWAG_MULTI_TOKEN_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/token.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+
+namespace wigwag
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Owns a group of connections, possibly to several signals. The ones that belong to the same signal are released together
+    class multi_token
+    {
+        using tokens_container = std::vector<token>;
+
+    private:
+        tokens_container        _tokens;
+
+    public:
+        multi_token()
+            : _tokens()
+        { }
+
+        explicit multi_token(tokens_container tokens)
+            : _tokens(std::move(tokens))
+        { }
+
+        multi_token(multi_token&& other) WIGWAG_NOEXCEPT
+            : _tokens(std::move(other._tokens))
+        { other._tokens.clear(); }
+
+        ~multi_token()
+        { reset(); }
+
+        multi_token(const multi_token&) = delete;
+        multi_token& operator = (const multi_token&) = delete;
+
+        multi_token& operator = (multi_token&& other) WIGWAG_NOEXCEPT
+        {
+            reset();
+
+            _tokens = std::move(other._tokens);
+            other._tokens.clear();
+
+            return *this;
+        }
+
+        multi_token& operator += (token&& t)
+        {
+            _tokens.push_back(std::move(t));
+            return *this;
+        }
+
+        multi_token& operator += (multi_token&& other)
+        {
+            if (_tokens.empty())
+                _tokens.swap(other._tokens);
+            else
+            {
+                _tokens.reserve(_tokens.size() + other._tokens.size());
+                std::move(other._tokens.begin(), other._tokens.end(), std::back_inserter(_tokens));
+                other._tokens.clear();
+            }
+            return *this;
+        }
+
+        void reserve(std::size_t count)
+        { _tokens.reserve(count); }
+
+        std::size_t size() const
+        { return _tokens.size(); }
+
+        bool empty() const
+        { return _tokens.empty(); }
+
+        void reset()
+        {
+            token::reset_all(_tokens.data(), _tokens.size());
+            _tokens.clear();
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef WIGWAG_OVERFLOW_POLICY_HPP
+#define WIGWAG_OVERFLOW_POLICY_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+namespace wigwag
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // What a bounded executor does with a new task when its queue is full.
+    // add_tasks applies the policy to the tasks one by one. If one of them fails, the tasks before it stay queued, and it and the rest are counted as dropped.
+    enum class overflow_policy
+    {
+        block,          // add_task waits until there is room, must not be used from the thread that processes the queue
+        drop_oldest,    // the oldest queued task is dropped, supported by threadless_task_executor only
+        drop_newest,    // the new task is dropped
+        fail            // add_task throws
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}
+
+#endif
@@ -11,8 +11,11 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <wigwag/policies/allocation/policies.hpp>
 #include <wigwag/policies/creation/policies.hpp>
 #include <wigwag/policies/exception_handling/policies.hpp>
+#include <wigwag/policies/handler_function/policies.hpp>
+#include <wigwag/policies/handlers_storage/policies.hpp>
 #include <wigwag/policies/life_assurance/policies.hpp>
 #include <wigwag/policies/ref_counter/policies.hpp>
 #include <wigwag/policies/state_populating/policies.hpp>
@@ -0,0 +1,39 @@
+#ifndef WIGWAG_POLICIES_HANDLER_FUNCTION_INPLACE_HPP
+#define WIGWAG_POLICIES_HANDLER_FUNCTION_INPLACE_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/inplace_function.hpp>
+#include <wigwag/policies/handler_function/tag.hpp>
+
+#include <cstddef>
+
+
+namespace wigwag {
+namespace handler_function
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    template < std::size_t Capacity_ = 2 * sizeof(void*) >
+    struct inplace
+    {
+        using tag = handler_function::tag<api_version<2, 0>>;
+
+        template < typename Signature_ >
+        using function = wigwag::detail::inplace_function<Signature_, Capacity_>;
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
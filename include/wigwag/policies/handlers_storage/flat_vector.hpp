@@ -0,0 +1,38 @@
+#ifndef WIGWAG_POLICIES_HANDLERS_STORAGE_FLAT_VECTOR_HPP
+#define WIGWAG_POLICIES_HANDLERS_STORAGE_FLAT_VECTOR_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/flat_list.hpp>
+#include <wigwag/policies/handlers_storage/tag.hpp>
+
+
+namespace wigwag {
+namespace handlers_storage
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    struct flat_vector
+    {
+        using tag = handlers_storage::tag<api_version<2, 0>>;
+
+        using node_base = wigwag::detail::flat_list_node;
+
+        template < typename Node_ >
+        using container = wigwag::detail::flat_list<Node_>;
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
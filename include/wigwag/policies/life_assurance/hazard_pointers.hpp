@@ -0,0 +1,134 @@
+#ifndef WIGWAG_POLICIES_LIFE_ASSURANCE_HAZARD_POINTERS_HPP
+#define WIGWAG_POLICIES_LIFE_ASSURANCE_HAZARD_POINTERS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/annotations.hpp>
+#include <wigwag/detail/config.hpp>
+#include <wigwag/detail/hazard_pointers.hpp>
+#include <wigwag/policies/life_assurance/tag.hpp>
+#include <wigwag/token.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+
+namespace wigwag {
+namespace life_assurance
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    struct hazard_pointers
+    {
+        using tag = life_assurance::tag<api_version<2, 0>>;
+
+        class life_checker;
+        class execution_guard;
+
+        class shared_data
+        { };
+
+
+        class life_assurance : public token::implementation
+        {
+            friend class life_checker;
+            friend class execution_guard;
+
+        private:
+            wigwag::detail::life_slot* const    _slot;
+            const std::uint64_t                 _alive_state;
+            bool                                _retired;
+            mutable std::atomic<int>            _ref_count;
+
+        public:
+            life_assurance()
+                : _slot(wigwag::detail::hazard_pointers::allocate_slot()), _alive_state(_slot->get_state()), _retired(false), _ref_count(2) // One ref in signal, another in token
+            { }
+
+            ~life_assurance()
+            {
+                if (!_retired)
+                    wigwag::detail::hazard_pointers::retire_slot(_slot);
+            }
+
+            life_assurance(const life_assurance&) = delete;
+            life_assurance& operator = (const life_assurance&) = delete;
+
+
+            void release_life_assurance(const shared_data&)
+            {
+                _retired = true;
+                wigwag::detail::hazard_pointers::retire_slot(_slot);
+            }
+
+            bool node_should_be_released() const
+            { return _ref_count == 1; }
+
+            bool release_node() const
+            {
+                if (--_ref_count == 0)
+                {
+                    WIGWAG_ANNOTATE_HAPPENS_AFTER(this);
+                    WIGWAG_ANNOTATE_RELEASE(this);
+
+                    return true;
+                }
+                else
+                {
+                    WIGWAG_ANNOTATE_HAPPENS_BEFORE(this);
+                    return false;
+                }
+            }
+        };
+
+
+        // Does not keep the node alive, the slot outlives it and tells whether the node is still there
+        class life_checker
+        {
+            friend class execution_guard;
+
+            const wigwag::detail::life_slot*    _slot;
+            std::uint64_t                       _alive_state;
+
+        public:
+            life_checker(const shared_data&, const life_assurance& la) WIGWAG_NOEXCEPT
+                : _slot(la._slot), _alive_state(la._alive_state)
+            { }
+        };
+
+        class execution_guard
+        {
+            wigwag::detail::hazard_pointers::guard  _guard;
+            bool                                    _alive;
+
+        public:
+            execution_guard(const life_checker& c)
+                : _guard(*c._slot), _alive(c._slot->get_state() == c._alive_state)
+            { }
+
+            execution_guard(const shared_data&, const life_assurance& la)
+                : _guard(*la._slot), _alive(la._slot->get_state() == la._alive_state)
+            { }
+
+            execution_guard(const execution_guard&) = delete;
+            execution_guard& operator = (const execution_guard&) = delete;
+
+            bool is_alive() const WIGWAG_NOEXCEPT
+            { return _alive; }
+        };
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -14,12 +14,12 @@
 #include <wigwag/detail/annotations.hpp>
 #include <wigwag/detail/config.hpp>
 #include <wigwag/detail/intrusive_ptr.hpp>
+#include <wigwag/detail/parking_lot.hpp>
 #include <wigwag/policies/life_assurance/tag.hpp>
+#include <wigwag/token.hpp>
 
 #include <atomic>
-#include <condition_variable>
 #include <limits>
-#include <mutex>
 
 
 namespace wigwag {
@@ -28,7 +28,8 @@ namespace life_assurance
 
 #include <wigwag/detail/disable_warnings.hpp>
 
-    struct intrusive_life_tokens
+    template < int SpinCount_ >
+    struct basic_intrusive_life_tokens
     {
         using tag = life_assurance::tag<api_version<2, 0>>;
 
@@ -38,23 +39,17 @@ namespace life_assurance
 
 
         class shared_data
-        {
-            friend class life_assurance;
-            friend class execution_guard;
-
-        private:
-            mutable std::condition_variable     _cond_var;
-            mutable std::mutex                  _mutex;
-        };
+        { };
 
 
-        class life_assurance
+        class life_assurance : public token::implementation
         {
             friend class life_checker;
             friend class execution_guard;
 
             using int_type = unsigned int;
             static const int_type alive_flag = ((int_type)1) << (std::numeric_limits<int_type>::digits - 1);
+            static const int_type waiting_flag = alive_flag >> 1;
 
             mutable std::atomic<int_type>       _lock_counter_and_alive_flag;
             mutable std::atomic<int>            _ref_count;
@@ -64,9 +59,6 @@ namespace life_assurance
                 : _lock_counter_and_alive_flag(alive_flag), _ref_count(2) // One ref in signal, another in token
             { }
 
-            virtual ~life_assurance()
-            { }
-
             life_assurance(const life_assurance&) = delete;
             life_assurance& operator = (const life_assurance&) = delete;
 
@@ -80,12 +72,16 @@ namespace life_assurance
                     delete this;
             }
 
-            void release_life_assurance(const shared_data& sd)
+            // Parks only the releasing thread, the last execution_guard wakes it only if it has set the waiting flag
+            void release_life_assurance(const shared_data&)
             {
                 _lock_counter_and_alive_flag -= alive_flag;
-                std::unique_lock<std::mutex> l(sd._mutex);
-                while (_lock_counter_and_alive_flag != 0)
-                    sd._cond_var.wait(l);
+                if (wigwag::detail::parking_lot::spin(SpinCount_, [&] { return _lock_counter_and_alive_flag == 0; }))
+                    return;
+
+                _lock_counter_and_alive_flag |= waiting_flag;
+                while (_lock_counter_and_alive_flag != waiting_flag)
+                    wigwag::detail::parking_lot::park(&_lock_counter_and_alive_flag, [&] { return _lock_counter_and_alive_flag != waiting_flag; });
             }
 
             bool node_should_be_released() const
@@ -113,31 +109,29 @@ namespace life_assurance
         {
             friend class execution_guard;
 
-            const shared_data*                              _sd;
             wigwag::detail::intrusive_ptr<const life_assurance>     _la;
 
         public:
-            life_checker(const shared_data& sd, const life_assurance& la) WIGWAG_NOEXCEPT
-                : _sd(&sd), _la(&la)
+            life_checker(const shared_data&, const life_assurance& la) WIGWAG_NOEXCEPT
+                : _la(&la)
             { la.add_ref(); }
         };
 
         class execution_guard
         {
-            const shared_data&                              _sd;
             const life_assurance*                           _la;
-            life_assurance::int_type                        _alive;
+            typename life_assurance::int_type               _alive;
 
         public:
             execution_guard(const life_checker& c)
-                : _sd(*c._sd), _la(c._la.get()), _alive(++c._la->_lock_counter_and_alive_flag & life_assurance::alive_flag)
+                : _la(c._la.get()), _alive(++c._la->_lock_counter_and_alive_flag & life_assurance::alive_flag)
             {
                 if (!_alive)
                     unlock();
             }
 
-            execution_guard(const shared_data& sd, const life_assurance& la)
-                : _sd(sd), _la(&la), _alive(++la._lock_counter_and_alive_flag & life_assurance::alive_flag)
+            execution_guard(const shared_data&, const life_assurance& la)
+                : _la(&la), _alive(++la._lock_counter_and_alive_flag & life_assurance::alive_flag)
             {
                 if (!_alive)
                     unlock();
@@ -152,20 +146,21 @@ namespace life_assurance
             execution_guard(const execution_guard&) = delete;
             execution_guard& operator = (const execution_guard&) = delete;
 
-            life_assurance::int_type is_alive() const WIGWAG_NOEXCEPT
+            typename life_assurance::int_type is_alive() const WIGWAG_NOEXCEPT
             { return _alive; }
 
         private:
             void unlock()
             {
-                life_assurance::int_type i = --_la->_lock_counter_and_alive_flag;
-                if (i == 0)
+                const void* key = &_la->_lock_counter_and_alive_flag;
+                typename life_assurance::int_type i = --_la->_lock_counter_and_alive_flag;
+                if (i == 0 || i == life_assurance::waiting_flag)
                 {
-                    WIGWAG_ANNOTATE_HAPPENS_AFTER(&_la->_lock_counter_and_alive_flag);
-                    WIGWAG_ANNOTATE_RELEASE(&_la->_lock_counter_and_alive_flag);
+                    WIGWAG_ANNOTATE_HAPPENS_AFTER(key);
+                    WIGWAG_ANNOTATE_RELEASE(key);
 
-                    std::unique_lock<std::mutex> l(_sd._mutex);
-                    _sd._cond_var.notify_all();
+                    if (i == life_assurance::waiting_flag)
+                        wigwag::detail::parking_lot::unpark_all(key);
                 }
                 else
                     WIGWAG_ANNOTATE_HAPPENS_BEFORE(&_la->_lock_counter_and_alive_flag);
@@ -173,6 +168,8 @@ namespace life_assurance
         };
     };
 
+    using intrusive_life_tokens = basic_intrusive_life_tokens<64>;
+
 #include <wigwag/detail/enable_warnings.hpp>
 
 }}
@@ -13,6 +13,7 @@
 
 #include <wigwag/detail/config.hpp>
 #include <wigwag/policies/life_assurance/tag.hpp>
+#include <wigwag/token.hpp>
 
 
 namespace wigwag {
@@ -28,7 +29,7 @@ namespace life_assurance
         class shared_data
         { };
 
-        struct life_assurance
+        struct life_assurance : public token::implementation
         {
             void release_life_assurance(const shared_data&)
             { }
@@ -11,6 +11,7 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <wigwag/policies/life_assurance/hazard_pointers.hpp>
 #include <wigwag/policies/life_assurance/intrusive_life_tokens.hpp>
 #include <wigwag/policies/life_assurance/none.hpp>
 #include <wigwag/policies/life_assurance/single_threaded.hpp>
@@ -14,6 +14,7 @@
 #include <wigwag/detail/config.hpp>
 #include <wigwag/detail/intrusive_ptr.hpp>
 #include <wigwag/policies/life_assurance/tag.hpp>
+#include <wigwag/token.hpp>
 
 
 namespace wigwag {
@@ -32,7 +33,7 @@ namespace life_assurance
         class shared_data
         { };
 
-        struct life_assurance
+        struct life_assurance : public token::implementation
         {
             friend class life_checker;
             friend class execution_guard;
@@ -46,9 +47,6 @@ namespace life_assurance
                 : _alive(true), _ref_count(2) // One ref in signal, another in token
             { }
 
-            virtual ~life_assurance()
-            { }
-
             life_assurance(const life_assurance&) = delete;
             life_assurance& operator = (const life_assurance&) = delete;
 
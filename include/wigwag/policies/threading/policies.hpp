@@ -11,11 +11,14 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <wigwag/policies/threading/copy_on_write.hpp>
 #include <wigwag/policies/threading/none.hpp>
 #include <wigwag/policies/threading/own_mutex.hpp>
 #include <wigwag/policies/threading/own_recursive_mutex.hpp>
+#include <wigwag/policies/threading/own_rw_mutex.hpp>
 #include <wigwag/policies/threading/shared_mutex.hpp>
 #include <wigwag/policies/threading/shared_recursive_mutex.hpp>
+#include <wigwag/policies/threading/shared_rw_mutex.hpp>
 
 namespace wigwag {
 namespace threading
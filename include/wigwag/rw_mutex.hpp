@@ -0,0 +1,105 @@
+#ifndef WIGWAG_RW_MUTEX_HPP
+#define WIGWAG_RW_MUTEX_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+
+#if WIGWAG_PLATFORM_POSIX
+#   include <pthread.h>
+#elif WIGWAG_PLATFORM_WINDOWS
+#   include <windows.h>
+#else
+#   error "Unknown platform!"
+#endif
+
+
+namespace wigwag
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    class rw_mutex
+    {
+    private:
+#if WIGWAG_PLATFORM_POSIX
+        pthread_rwlock_t    _rwlock;
+#elif WIGWAG_PLATFORM_WINDOWS
+        SRWLOCK             _rwlock;
+#endif
+
+    public:
+        rw_mutex()
+        {
+#if WIGWAG_PLATFORM_POSIX
+            if (pthread_rwlock_init(&_rwlock, nullptr) != 0)
+                WIGWAG_THROW("pthread_rwlock_init failed!");
+#elif WIGWAG_PLATFORM_WINDOWS
+            InitializeSRWLock(&_rwlock);
+#endif
+        }
+
+        ~rw_mutex()
+        {
+#if WIGWAG_PLATFORM_POSIX
+            pthread_rwlock_destroy(&_rwlock);
+#endif
+        }
+
+        rw_mutex(const rw_mutex&) = delete;
+        rw_mutex& operator = (const rw_mutex&) = delete;
+
+        void lock()
+        {
+#if WIGWAG_PLATFORM_POSIX
+            int res = pthread_rwlock_wrlock(&_rwlock);
+            WIGWAG_ASSERT(res == 0, "pthread_rwlock_wrlock failed!");
+            (void)res;
+#elif WIGWAG_PLATFORM_WINDOWS
+            AcquireSRWLockExclusive(&_rwlock);
+#endif
+        }
+
+        void unlock()
+        {
+#if WIGWAG_PLATFORM_POSIX
+            pthread_rwlock_unlock(&_rwlock);
+#elif WIGWAG_PLATFORM_WINDOWS
+            ReleaseSRWLockExclusive(&_rwlock);
+#endif
+        }
+
+        void lock_shared()
+        {
+#if WIGWAG_PLATFORM_POSIX
+            int res = pthread_rwlock_rdlock(&_rwlock);
+            WIGWAG_ASSERT(res == 0, "pthread_rwlock_rdlock failed!");
+            (void)res;
+#elif WIGWAG_PLATFORM_WINDOWS
+            AcquireSRWLockShared(&_rwlock);
+#endif
+        }
+
+        void unlock_shared()
+        {
+#if WIGWAG_PLATFORM_POSIX
+            pthread_rwlock_unlock(&_rwlock);
+#elif WIGWAG_PLATFORM_WINDOWS
+            ReleaseSRWLockShared(&_rwlock);
+#endif
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}
+
+#endif
@@ -15,9 +15,12 @@
 #include <wigwag/detail/policies_concepts.hpp>
 #include <wigwag/detail/policy_picker.hpp>
 #include <wigwag/detail/signal_impl.hpp>
+#include <wigwag/multi_token.hpp>
 #include <wigwag/policies.hpp>
 #include <wigwag/signal_connector.hpp>
 
+#include <iterator>
+
 
 namespace wigwag
 {
@@ -32,12 +35,19 @@ namespace wigwag
                 policies_config_entry<state_populating::policy_concept, wigwag::state_populating::default_>,
                 policies_config_entry<life_assurance::policy_concept, wigwag::life_assurance::default_>,
                 policies_config_entry<creation::policy_concept, wigwag::creation::default_>,
-                policies_config_entry<ref_counter::policy_concept, wigwag::ref_counter::default_>
+                policies_config_entry<ref_counter::policy_concept, wigwag::ref_counter::default_>,
+                policies_config_entry<handlers_storage::policy_concept, wigwag::handlers_storage::default_>,
+                policies_config_entry<handler_function::policy_concept, wigwag::handler_function::default_>,
+                policies_config_entry<allocation::policy_concept, wigwag::allocation::default_>
             >;
 
         template < typename T_ >
         struct signature_getter
         { using type = T_; };
+
+        template < typename T_ >
+        struct signal_param
+        { using type = typename std::conditional<std::is_reference<T_>::value, T_, const T_&>::type; };
     }
 
 
@@ -66,13 +76,16 @@ namespace wigwag
         using life_assurance_policy = policy<detail::life_assurance::policy_concept>;
         using creation_policy = policy<detail::creation::policy_concept>;
         using ref_counter_policy = policy<detail::ref_counter::policy_concept>;
+        using handlers_storage_policy = policy<detail::handlers_storage::policy_concept>;
+        using handler_function_policy = policy<detail::handler_function::policy_concept>;
+        using allocation_policy = policy<detail::allocation::policy_concept>;
 
     public:
-        using handler_type = std::function<signature>;
+        using handler_type = typename handler_function_policy::template function<signature>;
 
     WIGWAG_PRIVATE_IS_CONSTRUCTIBLE_WORKAROUND:
-        using impl_type = detail::signal_impl<signature, exception_handling_policy, threading_policy, state_populating_policy, life_assurance_policy, ref_counter_policy>;
-        using impl_type_with_attr = detail::signal_with_attributes_impl<signature, exception_handling_policy, threading_policy, state_populating_policy, life_assurance_policy, ref_counter_policy>;
+        using impl_type = detail::signal_impl<signature, exception_handling_policy, threading_policy, state_populating_policy, life_assurance_policy, ref_counter_policy, handlers_storage_policy, handler_function_policy, allocation_policy>;
+        using impl_type_with_attr = detail::signal_with_attributes_impl<signature, exception_handling_policy, threading_policy, state_populating_policy, life_assurance_policy, ref_counter_policy, handlers_storage_policy, handler_function_policy, allocation_policy>;
 
     private:
         using impl_type_ptr = detail::intrusive_ptr<impl_type>;
@@ -118,13 +131,21 @@ namespace wigwag
 
         template < typename HandlerFunc_ >
         token connect(HandlerFunc_ handler, handler_attributes attributes = handler_attributes::none) const
-        { return _impl->connect(std::move(handler), attributes); }
+        { return _impl->connect_handler(std::move(handler), attributes); }
 
         template < typename HandlerFunc_ >
         token connect(std::shared_ptr<task_executor> worker, HandlerFunc_ handler, handler_attributes attributes = handler_attributes::none) const
         { return _impl->connect(std::move(worker), std::move(handler), attributes); }
 
-        void operator() (ArgTypes_... args) const
+        template < typename HandlersRange_ >
+        multi_token connect_many(const HandlersRange_& handlers, handler_attributes attributes = handler_attributes::none) const
+        { return multi_token(_impl->connect_many_handlers(std::begin(handlers), std::end(handlers), attributes)); }
+
+        template < typename HandlersRange_ >
+        multi_token connect_many(std::shared_ptr<task_executor> worker, const HandlersRange_& handlers, handler_attributes attributes = handler_attributes::none) const
+        { return multi_token(_impl->connect_many_handlers(std::move(worker), std::begin(handlers), std::end(handlers), attributes)); }
+
+        void operator() (typename detail::signal_param<ArgTypes_>::type... args) const
         {
             if (_impl)
                 _impl->invoke(args...);
@@ -14,6 +14,10 @@
 #include <wigwag/detail/intrusive_ptr.hpp>
 #include <wigwag/detail/signal_connector_impl.hpp>
 #include <wigwag/handler_attributes.hpp>
+#include <wigwag/multi_token.hpp>
+
+#include <iterator>
+#include <vector>
 
 
 namespace wigwag
@@ -46,6 +50,14 @@ namespace wigwag
         template < typename HandlerFunc_ >
         token connect(std::shared_ptr<task_executor> worker, HandlerFunc_ handler, handler_attributes attributes = handler_attributes::none) const
         { return _impl->connect(std::move(worker), std::move(handler), attributes); }
+
+        template < typename HandlersRange_ >
+        multi_token connect_many(const HandlersRange_& handlers, handler_attributes attributes = handler_attributes::none) const
+        { return multi_token(_impl->connect_many(std::vector<handler_type>(std::begin(handlers), std::end(handlers)), attributes)); }
+
+        template < typename HandlersRange_ >
+        multi_token connect_many(std::shared_ptr<task_executor> worker, const HandlersRange_& handlers, handler_attributes attributes = handler_attributes::none) const
+        { return multi_token(_impl->connect_many(std::move(worker), std::vector<handler_type>(std::begin(handlers), std::end(handlers)), attributes)); }
     };
 
 #include <wigwag/detail/enable_warnings.hpp>
@@ -0,0 +1,73 @@
+#ifndef WIGWAG_STATIC_SIGNAL_HPP
+#define WIGWAG_STATIC_SIGNAL_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/listenable.hpp>
+
+#include <utility>
+
+
+namespace wigwag
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // A signal with a fixed handler type. The handlers are stored as they are, without an std::function wrapper, so their calls may be inlined
+    template <
+            typename Handler_,
+            typename... Policies_
+        >
+    class static_signal
+    {
+    public:
+        using handler_type = Handler_;
+
+    private:
+        using listenable_type = listenable<Handler_, Policies_...>;
+
+    private:
+        listenable_type     _listenable;
+
+    public:
+        template < bool E_ = std::is_constructible<listenable_type>::value, typename = typename std::enable_if<E_>::type>
+        static_signal()
+            : _listenable()
+        { }
+
+        template < typename Arg0_, typename... Args_ >
+        static_signal(Arg0_&& arg0, Args_&&... args)
+            : _listenable(std::forward<Arg0_>(arg0), std::forward<Args_>(args)...)
+        { }
+
+        static_signal(const static_signal&) = delete;
+        static_signal& operator = (const static_signal&) = delete;
+
+        auto lock_primitive() const -> decltype(_listenable.lock_primitive())
+        { return _listenable.lock_primitive(); }
+
+        token connect(Handler_ handler, handler_attributes attributes = handler_attributes::none) const
+        { return _listenable.connect(std::move(handler), attributes); }
+
+        template < typename HandlersRange_ >
+        multi_token connect_many(const HandlersRange_& handlers, handler_attributes attributes = handler_attributes::none) const
+        { return _listenable.connect_many(handlers, attributes); }
+
+        template < typename... Args_ >
+        void operator() (Args_&&... args) const
+        { _listenable.invoke([&](Handler_& handler) { handler(args...); }); }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}
+
+#endif
@@ -11,7 +11,12 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <wigwag/detail/inplace_function.hpp>
+
+#include <cstddef>
 #include <functional>
+#include <type_traits>
+#include <utility>
 
 
 namespace wigwag
@@ -19,11 +24,39 @@ namespace wigwag
 
 #include <wigwag/detail/disable_warnings.hpp>
 
+    // The callables of up to six pointers in size, the asynchronous handler calls among them, are stored inside the task without heap allocations.
+    // The bigger ones are put to the heap.
+    using task = detail::inplace_function<void(), 6 * sizeof(void*)>;
+
+
     struct task_executor
     {
         virtual ~task_executor() { }
 
-        virtual void add_task(std::function<void()> task) = 0;
+        virtual void add_task(task t) = 0;
+
+        template < typename F_, typename = typename std::enable_if<!std::is_same<typename std::decay<F_>::type, task>::value>::type >
+        void add_task(F_&& f)
+        { add_task(task(std::forward<F_>(f))); }
+
+        // Takes the ownership of the tasks by moving them out of the array
+        virtual void add_tasks(task* tasks, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                add_task(std::move(tasks[i]));
+        }
+    };
+
+
+    // A base for the executors written against the std::function interface that task_executor had before the task type was introduced
+    struct function_task_executor : public task_executor
+    {
+        using task_executor::add_task;
+
+        virtual void add_task(task t)
+        { add_task(std::function<void()>(std::move(t))); }
+
+        virtual void add_task(std::function<void()> f) = 0;
     };
 
 #include <wigwag/detail/enable_warnings.hpp>
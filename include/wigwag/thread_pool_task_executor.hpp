@@ -0,0 +1,286 @@
+#ifndef WIGWAG_THREAD_POOL_TASK_EXECUTOR_HPP
+#define WIGWAG_THREAD_POOL_TASK_EXECUTOR_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+#include <wigwag/detail/at_scope_exit.hpp>
+#include <wigwag/detail/config.hpp>
+#include <wigwag/detail/executor_statistics_collector.hpp>
+#include <wigwag/detail/policies_concepts.hpp>
+#include <wigwag/detail/policy_picker.hpp>
+#include <wigwag/executor_statistics.hpp>
+#include <wigwag/policies.hpp>
+#include <wigwag/task_executor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if WIGWAG_PLATFORM_POSIX && defined(__linux__)
+#   include <pthread.h>
+#   include <sched.h>
+#elif WIGWAG_PLATFORM_WINDOWS
+#   include <windows.h>
+#endif
+
+
+namespace wigwag
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    namespace detail
+    {
+        using thread_pool_task_executor_policies_config = policies_config<
+                policies_config_entry<exception_handling::policy_concept, wigwag::exception_handling::default_>
+            >;
+    }
+
+
+    // Every worker has its own deque of tasks. The tasks added from outside are spread among the workers in round-robin order,
+    // the tasks added by a worker go to its own deque. An idle worker steals the tasks from the back of the other workers' deques.
+    template < typename... Policies_ >
+    class basic_thread_pool_task_executor :
+        public task_executor,
+        private detail::policy_picker<detail::exception_handling::policy_concept, detail::thread_pool_task_executor_policies_config, Policies_...>::type
+    {
+        using exception_handling_policy = typename detail::policy_picker<detail::exception_handling::policy_concept, detail::thread_pool_task_executor_policies_config, Policies_...>::type;
+
+        struct worker
+        {
+            basic_thread_pool_task_executor*        owner;
+            std::size_t                             index;
+            std::mutex                              mutex;
+            std::deque<detail::timestamped_task>    tasks;
+            std::thread                             thread;
+
+            worker(basic_thread_pool_task_executor* owner_, std::size_t index_)
+                : owner(owner_), index(index_), mutex(), tasks(), thread()
+            { }
+        };
+
+        using workers_vector = std::vector<std::unique_ptr<worker>>;
+
+    private:
+        workers_vector              _workers;
+        std::atomic<std::size_t>    _next_worker;
+        std::atomic<long>           _pending_tasks;
+        std::atomic<std::size_t>    _sleeping_workers;
+        std::atomic<bool>           _alive;
+        std::mutex                  _mutex;
+        std::condition_variable     _cv;
+        detail::executor_statistics_collector   _statistics;
+
+    public:
+        explicit basic_thread_pool_task_executor(std::size_t threads_count = 0, bool pin_threads = false)
+            : _workers(), _next_worker(0), _pending_tasks(0), _sleeping_workers(0), _alive(true), _mutex(), _cv(), _statistics()
+        {
+            const std::size_t cpus_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+            if (threads_count == 0)
+                threads_count = cpus_count;
+
+            _workers.reserve(threads_count);
+            for (std::size_t i = 0; i < threads_count; ++i)
+                _workers.push_back(std::unique_ptr<worker>(new worker(this, i)));
+
+            bool started = false;
+            auto sg = detail::at_scope_exit([&] { if (!started) stop(); } );
+            for (auto& w : _workers)
+            {
+                w->thread = std::thread(&basic_thread_pool_task_executor::thread_func, this, w.get());
+                if (pin_threads)
+                    pin_thread(w->thread, w->index % cpus_count);
+            }
+            started = true;
+        }
+
+        ~basic_thread_pool_task_executor()
+        { stop(); }
+
+        std::size_t get_threads_count() const
+        { return _workers.size(); }
+
+        // The statistics are collected only after this call, it should be made before the executor is used by other threads.
+        // The busy time is summed over the workers.
+        void enable_statistics()
+        { _statistics.enable(); }
+
+        executor_statistics get_statistics() const
+        { return _statistics.get_statistics(0); }
+
+        using task_executor::add_task;
+
+        virtual void add_task(task t)
+        {
+            worker& w = get_target_worker();
+
+            // Counting the task before pushing it guarantees that the workers do not fall asleep while it is in the deque
+            ++_pending_tasks;
+            bool pushed = false;
+            auto sg = detail::at_scope_exit([&] { if (!pushed) --_pending_tasks; } );
+            {
+                std::lock_guard<std::mutex> l(w.mutex);
+                w.tasks.push_back(detail::timestamped_task(std::move(t), _statistics.on_enqueue(1)));
+                pushed = true;
+            }
+
+            wake_workers(1);
+        }
+
+        virtual void add_tasks(task* tasks, std::size_t count)
+        {
+            if (count == 0)
+                return;
+
+            worker& w = get_target_worker();
+
+            _pending_tasks += count;
+            std::size_t pushed = 0;
+            auto sg = detail::at_scope_exit([&] { if (pushed != count) _pending_tasks -= count - pushed; } );
+            {
+                std::int64_t enqueue_time = _statistics.on_enqueue(count);
+                std::lock_guard<std::mutex> l(w.mutex);
+                for (; pushed < count; ++pushed)
+                    w.tasks.push_back(detail::timestamped_task(std::move(tasks[pushed]), enqueue_time));
+            }
+
+            wake_workers(count);
+        }
+
+    private:
+        worker& get_target_worker()
+        {
+            worker* w = get_current_worker();
+            if (w && w->owner == this)
+                return *w;
+            return *_workers[_next_worker.fetch_add(1, std::memory_order_relaxed) % _workers.size()];
+        }
+
+        void wake_workers(std::size_t tasks_count)
+        {
+            if (_sleeping_workers == 0)
+                return;
+
+            std::lock_guard<std::mutex> l(_mutex);
+            if (tasks_count == 1)
+                _cv.notify_one();
+            else
+                _cv.notify_all();
+        }
+
+        void stop()
+        {
+            _alive = false;
+            {
+                std::lock_guard<std::mutex> l(_mutex);
+                _cv.notify_all();
+            }
+            for (auto& w : _workers)
+                if (w->thread.joinable())
+                    w->thread.join();
+        }
+
+        void thread_func(worker* w)
+        {
+            get_current_worker() = w;
+
+            detail::timestamped_task t;
+            do
+            {
+                while (pop_task(*w, t) || steal_task(*w, t))
+                {
+                    --_pending_tasks;
+                    _statistics.execute(t.enqueue_time, [&] { exception_handling_policy::handle_exceptions(t.t); });
+                    t.t = nullptr;
+                }
+            }
+            while (wait_for_tasks());
+        }
+
+        bool wait_for_tasks()
+        {
+            std::unique_lock<std::mutex> l(_mutex);
+            ++_sleeping_workers;
+            while (_pending_tasks <= 0)
+            {
+                if (!_alive)
+                {
+                    --_sleeping_workers;
+                    return false;
+                }
+                _cv.wait(l);
+            }
+            --_sleeping_workers;
+            return true;
+        }
+
+        static bool pop_task(worker& w, detail::timestamped_task& t)
+        {
+            std::lock_guard<std::mutex> l(w.mutex);
+            if (w.tasks.empty())
+                return false;
+            t = std::move(w.tasks.front());
+            w.tasks.pop_front();
+            return true;
+        }
+
+        bool steal_task(const worker& thief, detail::timestamped_task& t)
+        {
+            for (std::size_t i = 1; i < _workers.size(); ++i)
+            {
+                worker& victim = *_workers[(thief.index + i) % _workers.size()];
+                std::lock_guard<std::mutex> l(victim.mutex);
+                if (victim.tasks.empty())
+                    continue;
+                t = std::move(victim.tasks.back());
+                victim.tasks.pop_back();
+                return true;
+            }
+            return false;
+        }
+
+        static worker*& get_current_worker()
+        {
+            static thread_local worker* current_worker = nullptr;
+            return current_worker;
+        }
+
+        static void pin_thread(std::thread& t, std::size_t cpu)
+        {
+#if WIGWAG_PLATFORM_POSIX && defined(__linux__)
+            cpu_set_t cpu_set;
+            CPU_ZERO(&cpu_set);
+            CPU_SET(cpu, &cpu_set);
+            pthread_setaffinity_np(t.native_handle(), sizeof(cpu_set), &cpu_set);
+#elif WIGWAG_PLATFORM_WINDOWS
+            SetThreadAffinityMask(t.native_handle(), DWORD_PTR(1) << cpu);
+#else
+            (void)t;
+            (void)cpu;
+#endif
+        }
+    };
+
+
+    using thread_pool_task_executor = basic_thread_pool_task_executor<>;
+
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}
+
+#endif
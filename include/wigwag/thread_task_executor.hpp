@@ -11,12 +11,20 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 #include <wigwag/detail/at_scope_exit.hpp>
+#include <wigwag/detail/executor_statistics_collector.hpp>
+#include <wigwag/detail/mpsc_queue.hpp>
 #include <wigwag/detail/policies_concepts.hpp>
 #include <wigwag/detail/policy_picker.hpp>
+#include <wigwag/detail/task_queue_limiter.hpp>
+#include <wigwag/executor_statistics.hpp>
+#include <wigwag/overflow_policy.hpp>
 #include <wigwag/policies.hpp>
 #include <wigwag/task_executor.hpp>
 
-#include <queue>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
 #include <thread>
 
 
@@ -28,23 +36,32 @@ namespace wigwag
     namespace detail
     {
         using thread_task_executor_policies_config = policies_config<
-                policies_config_entry<exception_handling::policy_concept, wigwag::exception_handling::default_>
+                policies_config_entry<exception_handling::policy_concept, wigwag::exception_handling::default_>,
+                policies_config_entry<allocation::policy_concept, wigwag::allocation::default_>
             >;
     }
 
 
+    // The queue nodes come from the global allocator by default, basic_thread_task_executor<allocation::pooled> takes them from the node pool,
+    // so that posting a task does not call the global allocator in steady state.
     template < typename... Policies_ >
     class basic_thread_task_executor :
         public task_executor,
         private detail::policy_picker<detail::exception_handling::policy_concept, detail::thread_task_executor_policies_config, Policies_...>::type
     {
         using exception_handling_policy = typename detail::policy_picker<detail::exception_handling::policy_concept, detail::thread_task_executor_policies_config, Policies_...>::type;
+        using allocation_policy = typename detail::policy_picker<detail::allocation::policy_concept, detail::thread_task_executor_policies_config, Policies_...>::type;
 
-        using task_queue = std::queue<std::function<void()>>;
+        using task_queue = detail::mpsc_queue<detail::timestamped_task, allocation_policy>;
+
+        static const int spin_count = 64;
 
     private:
         task_queue                  _tasks;
-        bool                        _alive;
+        detail::task_queue_limiter  _limiter;
+        detail::executor_statistics_collector   _statistics;
+        std::atomic<bool>           _alive;
+        std::atomic<bool>           _sleeping;
         std::mutex                  _mutex;
         std::condition_variable     _cv;
         std::thread                 _thread;
@@ -52,52 +69,112 @@ namespace wigwag
     public:
         template < typename... Args_ >
         basic_thread_task_executor(Args_&... args)
-            : exception_handling_policy(std::forward<Args_>(args)...), _alive(true)
+            : exception_handling_policy(std::forward<Args_>(args)...), _limiter(), _statistics(), _alive(true), _sleeping(false)
         { _thread = std::thread(&basic_thread_task_executor::thread_func, this); }
 
         ~basic_thread_task_executor()
         {
+            _alive = false;
             {
                 std::lock_guard<std::mutex> l(_mutex);
-                _alive = false;
                 _cv.notify_all();
             }
             if (_thread.joinable())
                 _thread.join();
         }
 
-        virtual void add_task(std::function<void()> task)
+        // Should be called before the executor is used by other threads. The drop_oldest policy is not supported: the producers cannot remove
+        // the tasks from the lock-free queue, so the dropped tasks would stay in memory until the worker gets to them, and a stalled worker
+        // would let the queue grow without a limit.
+        void set_capacity(std::size_t capacity, overflow_policy policy = overflow_policy::block)
         {
-            std::lock_guard<std::mutex> l(_mutex);
-            bool need_wakeup = _tasks.empty();
-            _tasks.push(std::move(task));
-            if (need_wakeup)
-                _cv.notify_all();
+            if (policy == overflow_policy::drop_oldest)
+                WIGWAG_THROW("thread_task_executor does not support the drop_oldest overflow policy!");
+            _limiter.set_capacity(capacity, policy);
+        }
+
+        std::size_t get_dropped_tasks_count() const { return _limiter.get_dropped_count(); }
+        std::size_t get_blocked_tasks_count() const { return _limiter.get_blocked_count(); }
+
+        // The statistics are collected only after this call, it should be made before the executor is used by other threads
+        void enable_statistics()
+        { _statistics.enable(); }
+
+        executor_statistics get_statistics() const
+        { return _statistics.get_statistics(_limiter.get_dropped_count()); }
+
+        using task_executor::add_task;
+
+        virtual void add_task(task t)
+        {
+            if (_limiter.is_bounded() && !_limiter.acquire())
+                return;
+
+            _tasks.push(detail::timestamped_task(std::move(t), _statistics.on_enqueue(1)));
+            wake_worker();
+        }
+
+        virtual void add_tasks(task* tasks, std::size_t count)
+        {
+            if (_limiter.is_bounded())
+            {
+                _limiter.add_each(tasks, count, [&](task t) { add_task(std::move(t)); });
+                return;
+            }
+
+            _tasks.push(tasks, tasks + count, _statistics.on_enqueue(count));
+            wake_worker();
         }
 
     private:
+        void wake_worker()
+        {
+            // The worker sets _sleeping before it checks the queue for the last time, so either it sees the new tasks or we see it sleeping
+            if (_sleeping)
+            {
+                std::lock_guard<std::mutex> l(_mutex);
+                _cv.notify_all();
+            }
+        }
+
         void thread_func()
         {
+            do
+            {
+                while (_tasks.consume_all([&](detail::timestamped_task& t) { execute_task(t); }) != 0)
+                    ;
+            }
+            while (wait_for_tasks());
+        }
+
+        void execute_task(detail::timestamped_task& t)
+        {
+            if (WIGWAG_EXPECT(_limiter.is_bounded(), 0))
+                _limiter.release();
+            _statistics.execute(t.enqueue_time, [&] { exception_handling_policy::handle_exceptions(t.t); });
+        }
+
+        bool wait_for_tasks()
+        {
+            // Producers usually come in bursts, so yielding for a while is cheaper than parking and being woken up
+            for (int i = 0; i < spin_count; ++i)
+            {
+                if (!_tasks.empty())
+                    return true;
+                std::this_thread::yield();
+            }
+
             std::unique_lock<std::mutex> l(_mutex);
-            while (_alive || !_tasks.empty())
+            _sleeping = true;
+            auto sg = detail::at_scope_exit([&] { _sleeping = false; } );
+
+            while (_tasks.empty())
             {
-                if (_tasks.empty())
-                {
-                    _cv.wait(l);
-                    continue;
-                }
-
-                exception_handling_policy::handle_exceptions([&]() {
-                        std::function<void()> task;
-                        std::swap(_tasks.front(), task);
-                        _tasks.pop();
-
-                        l.unlock();
-                        auto sg = detail::at_scope_exit([&] { l.lock(); } );
-
-                        task();
-                    } );
+                if (!_alive)
+                    return false;
+                _cv.wait(l);
             }
+            return true;
         }
     };
 
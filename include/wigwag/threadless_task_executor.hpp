@@ -11,13 +11,24 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <wigwag/detail/at_scope_exit.hpp>
+#include <wigwag/detail/executor_statistics_collector.hpp>
 #include <wigwag/detail/policies_concepts.hpp>
 #include <wigwag/detail/policy_picker.hpp>
+#include <wigwag/detail/task_queue_limiter.hpp>
+#include <wigwag/executor_statistics.hpp>
+#include <wigwag/overflow_policy.hpp>
 #include <wigwag/policies.hpp>
 #include <wigwag/task_executor.hpp>
 
-#include <queue>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <thread>
+#include <vector>
 
 
 namespace wigwag
@@ -45,49 +56,220 @@ namespace wigwag
         using exception_handling_policy = policy<detail::exception_handling::policy_concept>;
         using threading_policy = policy<detail::threading::policy_concept>;
 
-        using task_queue = std::queue<std::function<void()>>;
+        using task_vector = std::vector<detail::timestamped_task>;
 
         using lock_primitive = typename threading_policy::lock_primitive;
 
     private:
-        task_queue              _tasks;
+        task_vector             _tasks;
+        task_vector             _spare_tasks;
+        task_vector             _backlog;
+        std::size_t             _backlog_pos;
         lock_primitive          _lp;
+        std::function<void()>   _wakeup_handler;
+
+        detail::task_queue_limiter  _limiter;
+        std::atomic<std::size_t>    _in_flight_count;
+        detail::executor_statistics_collector   _statistics;
 
     public:
         template < typename... Args_ >
         basic_threadless_task_executor(Args_&... args)
-            : exception_handling_policy(std::forward<Args_>(args)...)
+            : exception_handling_policy(std::forward<Args_>(args)...), _tasks(), _spare_tasks(), _backlog(), _backlog_pos(0), _lp(), _wakeup_handler(), _limiter(), _in_flight_count(0), _statistics()
         { }
 
         ~basic_threadless_task_executor()
         { }
 
-        virtual void add_task(std::function<void()> task)
+        // The handler is called outside the lock when the tasks arrive to an empty queue, e.g. to notify a wakeup_fd of the owning event loop.
+        // It should be set before the executor is used by other threads.
+        void set_wakeup_handler(std::function<void()> handler)
+        { _wakeup_handler = std::move(handler); }
+
+        // Should be called before the executor is used by other threads. The block policy must not be used if the tasks are posted from the thread that processes them
+        void set_capacity(std::size_t capacity, overflow_policy policy = overflow_policy::block)
+        { _limiter.set_capacity(capacity, policy); }
+
+        std::size_t get_dropped_tasks_count() const { return _limiter.get_dropped_count(); }
+        std::size_t get_blocked_tasks_count() const { return _limiter.get_blocked_count(); }
+
+        // The statistics are collected only after this call, it should be made before the executor is used by other threads
+        void enable_statistics()
+        { _statistics.enable(); }
+
+        executor_statistics get_statistics() const
+        { return _statistics.get_statistics(_limiter.get_dropped_count()); }
+
+        using task_executor::add_task;
+
+        virtual void add_task(task t)
+        {
+            if (_limiter.is_bounded() && !_limiter.acquire())
+                return;
+
+            detail::timestamped_task dropped;
+            bool was_empty = false;
+            {
+                _lp.lock_nonrecursive();
+                auto sg = detail::at_scope_exit([&] { _lp.unlock_nonrecursive(); } );
+
+                if (_limiter.is_bounded())
+                    drop_oldest_pending_task(dropped);
+
+                was_empty = _tasks.empty();
+                _tasks.push_back(detail::timestamped_task(std::move(t), _statistics.on_enqueue(1)));
+            }
+
+            if (was_empty && _wakeup_handler)
+                _wakeup_handler();
+        }
+
+        virtual void add_tasks(task* tasks, std::size_t count)
+        {
+            if (count == 0)
+                return;
+
+            if (_limiter.is_bounded())
+            {
+                _limiter.add_each(tasks, count, [&](task t) { add_task(std::move(t)); });
+                return;
+            }
+
+            bool was_empty = false;
+            {
+                _lp.lock_nonrecursive();
+                auto sg = detail::at_scope_exit([&] { _lp.unlock_nonrecursive(); } );
+
+                was_empty = _tasks.empty();
+                std::int64_t enqueue_time = _statistics.on_enqueue(count);
+                for (std::size_t i = 0; i < count; ++i)
+                    _tasks.push_back(detail::timestamped_task(std::move(tasks[i]), enqueue_time));
+            }
+
+            if (was_empty && _wakeup_handler)
+                _wakeup_handler();
+        }
+
+        void process_tasks()
+        { do_process_tasks([] { return false; }); }
+
+        // Executes at most max_tasks tasks, returns the number of the remaining ones
+        std::size_t process_tasks(std::size_t max_tasks)
+        { return do_process_tasks([&] { return max_tasks-- == 0; }); }
+
+        // Executes the tasks until the deadline is reached, returns the number of the remaining ones
+        template < typename Clock_, typename Duration_ >
+        std::size_t process_tasks_until(const std::chrono::time_point<Clock_, Duration_>& deadline)
+        { return do_process_tasks([&] { return Clock_::now() >= deadline; }); }
+
+        std::size_t get_pending_tasks_count() const
         {
             _lp.lock_nonrecursive();
             auto sg = detail::at_scope_exit([&] { _lp.unlock_nonrecursive(); } );
 
-            _tasks.push(std::move(task));
+            return pending_tasks_count();
         }
 
-        void process_tasks()
+    private:
+        std::size_t pending_tasks_count() const
+        { return _tasks.size() + _backlog.size() - _backlog_pos; }
+
+        // The excess of the drop_oldest policy is dropped from the pending tasks right away, so that they do not pile up while nobody processes them.
+        // The tasks that are being processed are older than the pending ones, so that much of the excess is left for the consumer, that drops them
+        // when it dequeues them. The pending tasks are moved to the backlog to drop them one by one from its front.
+        void drop_oldest_pending_task(detail::timestamped_task& dropped)
+        {
+            if (pending_tasks_count() == 0 || !_limiter.take_excess(_in_flight_count))
+                return;
+
+            if (_backlog.empty())
+            {
+                _backlog.swap(_tasks);
+                _backlog_pos = 0;
+            }
+
+            dropped = std::move(_backlog[_backlog_pos++]);
+            _statistics.on_discard();
+            if (_backlog_pos == _backlog.size())
+            {
+                _backlog.clear();
+                _backlog_pos = 0;
+            }
+            _limiter.release();
+        }
+
+        template < typename ShouldStopFunc_ >
+        std::size_t do_process_tasks(const ShouldStopFunc_& should_stop)
         {
             _lp.lock_nonrecursive();
             auto sg = detail::at_scope_exit([&] { _lp.unlock_nonrecursive(); } );
 
-            while (!_tasks.empty())
+            while ((!_backlog.empty() || !_tasks.empty()) && process_pending_tasks(should_stop))
+                ;
+
+            return pending_tasks_count();
+        }
+
+        // The pending tasks are swapped out and executed without the lock, the two vectors take turns so that their memory is reused.
+        // The tasks left after a stop go first on the next call, before the ones that were moved to the backlog in the meantime.
+        template < typename ShouldStopFunc_ >
+        bool process_pending_tasks(const ShouldStopFunc_& should_stop)
+        {
+            task_vector tasks;
+            std::size_t processed = 0;
+            if (!_backlog.empty())
             {
-                exception_handling_policy::handle_exceptions([&]() {
-                        std::function<void()> task;
-                        std::swap(_tasks.front(), task);
-                        _tasks.pop();
+                tasks.swap(_backlog);
+                processed = _backlog_pos;
+                _backlog_pos = 0;
+            }
+            else
+            {
+                tasks.swap(_spare_tasks);
+                tasks.swap(_tasks);
+            }
+
+            _in_flight_count = tasks.size() - processed;
 
-                        _lp.unlock_nonrecursive();
-                        auto sg = detail::at_scope_exit([&] { _lp.lock_nonrecursive(); } );
+            auto restore_sg = detail::at_scope_exit([&] {
+                    _in_flight_count = 0;
+                    if (processed != tasks.size())
+                    {
+                        if (_backlog.empty())
+                        {
+                            _backlog.swap(tasks);
+                            _backlog_pos = processed;
+                            return;
+                        }
+                        _backlog.erase(_backlog.begin(), _backlog.begin() + _backlog_pos);
+                        _backlog.insert(_backlog.begin(), std::make_move_iterator(tasks.begin() + processed), std::make_move_iterator(tasks.end()));
+                        _backlog_pos = 0;
+                    }
+                    tasks.clear();
+                    _spare_tasks.swap(tasks);
+                } );
+
+            _lp.unlock_nonrecursive();
+            auto relock_sg = detail::at_scope_exit([&] { _lp.lock_nonrecursive(); } );
+
+            while (processed != tasks.size())
+            {
+                if (should_stop())
+                    return false;
 
-                        task();
-                    } );
+                detail::timestamped_task t(std::move(tasks[processed++]));
+                if (WIGWAG_EXPECT(_limiter.is_bounded(), 0))
+                {
+                    --_in_flight_count;
+                    if (_limiter.release_dequeued())
+                    {
+                        _statistics.on_discard();
+                        continue;
+                    }
+                }
+                _statistics.execute(t.enqueue_time, [&] { exception_handling_policy::handle_exceptions(t.t); });
             }
+            return true;
         }
     };
 
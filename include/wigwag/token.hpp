@@ -11,7 +11,13 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <wigwag/detail/config.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <vector>
 
 
 namespace wigwag
@@ -26,6 +32,17 @@ namespace wigwag
         {
             virtual void release_token_impl() = 0;
             virtual ~implementation() { }
+
+            // The implementations with equal keys may be released by a single release_token_impls call
+            virtual const void* get_batch_key() const
+            { return this; }
+
+            // Called on one of impls, all of them have the same batch key
+            virtual void release_token_impls(implementation** impls, std::size_t count)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                    impls[i]->release_token_impl();
+            }
         };
 
     private:
@@ -41,7 +58,7 @@ namespace wigwag
             : _impl(nullptr)
         { }
 
-        token(token&& other)
+        token(token&& other) WIGWAG_NOEXCEPT
             : _impl(other._impl)
         { other._impl = nullptr; }
 
@@ -51,7 +68,7 @@ namespace wigwag
         token(const token&) = delete;
         token& operator = (const token&) = delete;
 
-        token& operator = (token&& other)
+        token& operator = (token&& other) WIGWAG_NOEXCEPT
         {
             reset();
 
@@ -70,6 +87,31 @@ namespace wigwag
             _impl = nullptr;
         }
 
+        // Resets all the tokens, the ones that belong to the same signal are released together
+        static void reset_all(token* tokens, std::size_t count)
+        {
+            std::vector<implementation*> impls;
+            impls.reserve(count);
+            for (std::size_t i = 0; i < count; ++i)
+                if (tokens[i]._impl)
+                {
+                    impls.push_back(tokens[i]._impl);
+                    tokens[i]._impl = nullptr;
+                }
+
+            auto key_less = [](implementation* l, implementation* r) { return std::less<const void*>()(l->get_batch_key(), r->get_batch_key()); };
+            if (!std::is_sorted(impls.begin(), impls.end(), key_less))
+                std::stable_sort(impls.begin(), impls.end(), key_less);
+
+            for (std::size_t begin = 0, end = 0; begin != impls.size(); begin = end)
+            {
+                const void* key = impls[begin]->get_batch_key();
+                for (end = begin + 1; end != impls.size() && impls[end]->get_batch_key() == key; ++end)
+                    ;
+                impls[begin]->release_token_impls(&impls[begin], end - begin);
+            }
+        }
+
         template < typename Implementation_, typename... Args_ >
         static token create(Args_&&... args)
         { return token(new Implementation_(std::forward<Args_>(args)...)); }
@@ -11,9 +11,9 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <wigwag/detail/mpsc_queue.hpp>
 #include <wigwag/token.hpp>
 
-#include <mutex>
 #include <vector>
 
 
@@ -22,15 +22,26 @@ namespace wigwag
 
 #include <wigwag/detail/disable_warnings.hpp>
 
+    // Adding a token is a single lock-free push. release() takes all the tokens at once and resets them outside of any lock,
+    // so a handler that is being waited for may add tokens to the same pool.
     class token_pool
     {
-        using tokens_container = std::vector<token>;
+        using tokens_container = detail::mpsc_queue<token>;
 
     private:
         tokens_container        _tokens;
-        mutable std::mutex      _mutex;
 
     public:
+        token_pool()
+            : _tokens()
+        { }
+
+        ~token_pool()
+        { release(); }
+
+        token_pool(const token_pool&) = delete;
+        token_pool& operator = (const token_pool&) = delete;
+
         token_pool& operator += (token&& t)
         {
             add_token(std::move(t));
@@ -38,15 +49,13 @@ namespace wigwag
         }
 
         void add_token(token&& t)
-        {
-            std::lock_guard<std::mutex> l(_mutex);
-            _tokens.push_back(std::move(t));
-        }
+        { _tokens.push(std::move(t)); }
 
         void release()
         {
-            std::lock_guard<std::mutex> l(_mutex);
-            _tokens.clear();
+            std::vector<token> tokens;
+            _tokens.consume_all([&](token& t) { tokens.push_back(std::move(t)); });
+            token::reset_all(tokens.data(), tokens.size());
         }
     };
 
@@ -0,0 +1,109 @@
+#ifndef WIGWAG_WAKEUP_FD_HPP
+#define WIGWAG_WAKEUP_FD_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+
+#include <stdexcept>
+
+#if WIGWAG_PLATFORM_POSIX
+#   include <errno.h>
+#   include <fcntl.h>
+#   include <stdint.h>
+#   include <unistd.h>
+#   if defined(__linux__)
+#       include <sys/eventfd.h>
+#   endif
+#else
+#   error "wakeup_fd is supported on POSIX platforms only!"
+#endif
+
+
+namespace wigwag
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // A file descriptor that becomes readable after notify() and stays so until clear(), to be registered in a poll/epoll loop.
+    // An eventfd on Linux, a nonblocking pipe elsewhere. The loop should call clear() before processing the work, so that no notification is lost.
+    class wakeup_fd
+    {
+    private:
+        int     _read_fd;
+        int     _write_fd;
+
+    public:
+        wakeup_fd()
+            : _read_fd(-1), _write_fd(-1)
+        {
+#if defined(__linux__)
+            _read_fd = _write_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (_read_fd == -1)
+                WIGWAG_THROW("eventfd failed!");
+#else
+            int fds[2];
+            if (pipe(fds) != 0)
+                WIGWAG_THROW("pipe failed!");
+            _read_fd = fds[0];
+            _write_fd = fds[1];
+            for (int fd : fds)
+            {
+                fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+                fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+            }
+#endif
+        }
+
+        ~wakeup_fd()
+        {
+            if (_write_fd != _read_fd)
+                close(_write_fd);
+            close(_read_fd);
+        }
+
+        wakeup_fd(const wakeup_fd&) = delete;
+        wakeup_fd& operator = (const wakeup_fd&) = delete;
+
+        int get_fd() const
+        { return _read_fd; }
+
+        // A failure with EAGAIN means that the descriptor is readable already
+        void notify() const
+        {
+#if defined(__linux__)
+            uint64_t value = 1;
+#else
+            char value = 0;
+#endif
+            while (write(_write_fd, &value, sizeof(value)) < 0 && errno == EINTR)
+                ;
+        }
+
+        void clear() const
+        {
+#if defined(__linux__)
+            uint64_t value = 0;
+            while (read(_read_fd, &value, sizeof(value)) < 0 && errno == EINTR)
+                ;
+#else
+            char buf[64];
+            for (ssize_t res = 0; (res = read(_read_fd, buf, sizeof(buf))) > 0 || (res < 0 && errno == EINTR); )
+                ;
+#endif
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef SRC_BENCHMARKS_ASYNCSIGNALBENCHMARKS_HPP
+#define SRC_BENCHMARKS_ASYNCSIGNALBENCHMARKS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <benchmarks/BenchmarkClass.hpp>
+#include <benchmarks/utils/Storage.hpp>
+
+#include <wigwag/thread_task_executor.hpp>
+#include <wigwag/threadless_task_executor.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+
+namespace benchmarks
+{
+
+    template < typename SignalsDesc_ >
+    class AsyncSignalBenchmarks : public BenchmarksClass
+    {
+        using SignalType = typename SignalsDesc_::SignalType;
+        using HandlerType = typename SignalsDesc_::HandlerType;
+        using ConnectionType = typename SignalsDesc_::ConnectionType;
+
+    public:
+        AsyncSignalBenchmarks()
+            : BenchmarksClass("asyncSignal")
+        {
+            AddBenchmark<int64_t>("invoke", &AsyncSignalBenchmarks::Invoke, {"numSlots"});
+            AddBenchmark<int64_t>("invokeConflated", &AsyncSignalBenchmarks::InvokeConflated, {"numSlots"});
+            AddBenchmark<>("latency", &AsyncSignalBenchmarks::Latency);
+        }
+
+    private:
+        static void Invoke(BenchmarkContext& context, int64_t numSlots)
+        {
+            const auto n = context.GetIterationsCount();
+
+            auto worker = std::make_shared<::wigwag::threadless_task_executor>();
+            HandlerType handler = SignalsDesc_::MakeHandler();
+            SignalType s;
+            StorageArray<ConnectionType> c(numSlots);
+
+            c.Construct([&]{ return s.connect(worker, handler); });
+
+            {
+                auto op = context.Profile("invoke", numSlots * n);
+                for (int64_t i = 0; i < n; ++i)
+                    s();
+            }
+
+            context.MeasureMemory("task", numSlots * n);
+            context.Profile("process", numSlots * n, [&]{ worker->process_tasks(); });
+
+            c.Destruct();
+        }
+
+        static void InvokeConflated(BenchmarkContext& context, int64_t numSlots)
+        {
+            const auto n = context.GetIterationsCount();
+
+            auto worker = std::make_shared<::wigwag::threadless_task_executor>();
+            HandlerType handler = SignalsDesc_::MakeHandler();
+            SignalType s;
+            StorageArray<ConnectionType> c(numSlots);
+
+            c.Construct([&]{ return s.connect(worker, handler, ::wigwag::handler_attributes::conflate); });
+
+            {
+                auto op = context.Profile("invoke", numSlots * n);
+                for (int64_t i = 0; i < n; ++i)
+                    s();
+            }
+
+            context.Profile("process", numSlots, [&]{ worker->process_tasks(); });
+
+            c.Destruct();
+        }
+
+        static void Latency(BenchmarkContext& context)
+        {
+            const auto n = context.GetIterationsCount();
+
+            auto worker = std::make_shared<::wigwag::thread_task_executor>();
+            std::atomic<int64_t> counter(0);
+            SignalType s;
+            ConnectionType c(s.connect(worker, [&]{ counter.fetch_add(1, std::memory_order_release); }));
+
+            {
+                auto op = context.Profile("roundtrip", n);
+                for (int64_t i = 0; i < n; ++i)
+                {
+                    s();
+                    while (counter.load(std::memory_order_acquire) != i + 1)
+                        std::this_thread::yield();
+                }
+            }
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef SRC_BENCHMARKS_BULKCONNECTBENCHMARKS_HPP
+#define SRC_BENCHMARKS_BULKCONNECTBENCHMARKS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <benchmarks/BenchmarkClass.hpp>
+
+#include <vector>
+
+
+namespace benchmarks
+{
+
+    template < typename SignalsDesc_ >
+    class BulkConnectBenchmarks : public BenchmarksClass
+    {
+        using SignalType = typename SignalsDesc_::SignalType;
+        using HandlerType = typename SignalsDesc_::HandlerType;
+
+    public:
+        BulkConnectBenchmarks()
+            : BenchmarksClass("bulkConnect")
+        {
+            AddBenchmark<int64_t>("connectMany", &BulkConnectBenchmarks::ConnectMany, {"numSlots"});
+        }
+
+    private:
+        static void ConnectMany(BenchmarkContext& context, int64_t numSlots)
+        {
+            const auto n = context.GetIterationsCount();
+
+            std::vector<HandlerType> handlers(numSlots, SignalsDesc_::MakeHandler());
+            std::vector<SignalType> s(n);
+            std::vector<::wigwag::multi_token> c(n);
+
+            {
+                auto op = context.Profile("connect", numSlots * n);
+                for (int64_t j = 0; j < n; ++j)
+                    c[j] = s[j].connect_many(handlers);
+            }
+
+            context.Profile("disconnect", numSlots * n, [&]{ c.clear(); });
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef SRC_BENCHMARKS_CONCURRENTSIGNALBENCHMARKS_HPP
+#define SRC_BENCHMARKS_CONCURRENTSIGNALBENCHMARKS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <benchmarks/BenchmarkClass.hpp>
+#include <benchmarks/utils/Storage.hpp>
+
+#include <atomic>
+#include <thread>
+
+
+namespace benchmarks
+{
+
+    template < typename SignalsDesc_ >
+    class ConcurrentSignalBenchmarks : public BenchmarksClass
+    {
+        using SignalType = typename SignalsDesc_::SignalType;
+        using HandlerType = typename SignalsDesc_::HandlerType;
+        using ConnectionType = typename SignalsDesc_::ConnectionType;
+
+    public:
+        ConcurrentSignalBenchmarks()
+            : BenchmarksClass("concurrentSignal")
+        {
+            AddBenchmark<int64_t>("invokeWithChurn", &ConcurrentSignalBenchmarks::InvokeWithChurn, {"numSlots"});
+        }
+
+    private:
+        static void InvokeWithChurn(BenchmarkContext& context, int64_t numSlots)
+        {
+            const auto n = context.GetIterationsCount();
+
+            HandlerType handler = SignalsDesc_::MakeHandler();
+            SignalType s;
+            StorageArray<ConnectionType> c(numSlots);
+
+            c.Construct([&]{ return s.connect(handler); });
+
+            std::atomic<bool> alive(true);
+            std::thread churn_thread([&]
+                {
+                    while (alive)
+                        ConnectionType(s.connect(handler));
+                });
+
+            {
+                auto op = context.Profile("invoke", numSlots * n);
+                for (int64_t i = 0; i < n; ++i)
+                    s();
+            }
+
+            alive = false;
+            churn_thread.join();
+
+            c.Destruct();
+        }
+    };
+
+}
+
+#endif
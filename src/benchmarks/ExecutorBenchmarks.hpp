@@ -0,0 +1,67 @@
+#ifndef SRC_BENCHMARKS_EXECUTORBENCHMARKS_HPP
+#define SRC_BENCHMARKS_EXECUTORBENCHMARKS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <benchmarks/BenchmarkClass.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+namespace benchmarks
+{
+
+    template < typename ExecutorDesc_ >
+    class ExecutorBenchmarks : public BenchmarksClass
+    {
+        using ExecutorType = typename ExecutorDesc_::ExecutorType;
+
+    public:
+        ExecutorBenchmarks()
+            : BenchmarksClass("executor")
+        {
+            AddBenchmark<int64_t>("addTasks", &ExecutorBenchmarks::AddTasks, {"numProducers"});
+        }
+
+    private:
+        static void AddTasks(BenchmarkContext& context, int64_t numProducers)
+        {
+            const auto n = context.GetIterationsCount();
+
+            std::atomic<int64_t> counter(0);
+            std::vector<std::thread> producers;
+
+            {
+                auto op = context.Profile("task", numProducers * n);
+
+                ExecutorType executor;
+                for (int64_t i = 0; i < numProducers; ++i)
+                    producers.emplace_back([&]
+                        {
+                            for (int64_t j = 0; j < n; ++j)
+                                executor.add_task([&]{ counter.fetch_add(1, std::memory_order_relaxed); });
+                        });
+
+                for (auto& t : producers)
+                    t.join();
+            }
+
+            if (counter != numProducers * n)
+                throw std::runtime_error("Not all the tasks were executed!");
+        }
+    };
+
+}
+
+#endif
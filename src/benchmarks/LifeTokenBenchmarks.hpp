@@ -0,0 +1,79 @@
+#ifndef BENCHMARKS_LIFETOKENBENCHMARKS_HPP
+#define BENCHMARKS_LIFETOKENBENCHMARKS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <benchmarks/BenchmarkClass.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+
+namespace benchmarks
+{
+
+    template < typename Desc_ >
+    class LifeTokenBenchmarks : public BenchmarksClass
+    {
+        using Type = typename Desc_::Type;
+
+    public:
+        LifeTokenBenchmarks()
+            : BenchmarksClass("lifeToken")
+        {
+            AddBenchmark<>("releaseWhileExecuting", &LifeTokenBenchmarks::ReleaseWhileExecuting);
+        }
+
+    private:
+        // Another thread holds an execution guard for a couple of microseconds, like a short handler does
+        static void ReleaseWhileExecuting(BenchmarkContext& context)
+        {
+            const auto n = context.GetIterationsCount();
+
+            std::atomic<Type*> current(nullptr);
+            std::atomic<int64_t> executing(0);
+
+            std::thread executor([&]
+                {
+                    for (int64_t i = 0; i < n; ++i)
+                    {
+                        Type* t = nullptr;
+                        while (!(t = current.exchange(nullptr, std::memory_order_acquire)))
+                            std::this_thread::yield();
+
+                        typename Type::execution_guard g(*t);
+                        executing.store(i + 1, std::memory_order_release);
+                        auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(2);
+                        while (std::chrono::steady_clock::now() < end)
+                            ;
+                    }
+                });
+
+            {
+                auto op = context.Profile("release", n);
+                for (int64_t i = 0; i < n; ++i)
+                {
+                    Type t;
+                    current.store(&t, std::memory_order_release);
+                    while (executing.load(std::memory_order_acquire) != i + 1)
+                        std::this_thread::yield();
+                    t.release();
+                }
+            }
+
+            executor.join();
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef BENCHMARKS_DESCRIPTORS_EXECUTOR_WIGWAG_HPP
+#define BENCHMARKS_DESCRIPTORS_EXECUTOR_WIGWAG_HPP
+
+
+#include <wigwag/thread_pool_task_executor.hpp>
+#include <wigwag/thread_task_executor.hpp>
+
+#include <string>
+
+
+namespace descriptors {
+namespace executor {
+namespace wigwag
+{
+
+	struct ThreadTaskExecutor
+	{
+		using ExecutorType = ::wigwag::thread_task_executor;
+		static ::std::string GetName() { return "wigwag"; }
+	};
+
+	struct PooledThreadTaskExecutor
+	{
+		using ExecutorType = ::wigwag::basic_thread_task_executor<::wigwag::allocation::pooled>;
+		static ::std::string GetName() { return "wigwag_pooled"; }
+	};
+
+	class BoundedThreadTaskExecutorImpl : public ::wigwag::thread_task_executor
+	{
+	public:
+		BoundedThreadTaskExecutorImpl()
+		{ set_capacity(1024, ::wigwag::overflow_policy::block); }
+	};
+
+	struct BoundedThreadTaskExecutor
+	{
+		using ExecutorType = BoundedThreadTaskExecutorImpl;
+		static ::std::string GetName() { return "wigwag_bounded"; }
+	};
+
+	class InstrumentedThreadTaskExecutorImpl : public ::wigwag::thread_task_executor
+	{
+	public:
+		InstrumentedThreadTaskExecutorImpl()
+		{ enable_statistics(); }
+	};
+
+	struct InstrumentedThreadTaskExecutor
+	{
+		using ExecutorType = InstrumentedThreadTaskExecutorImpl;
+		static ::std::string GetName() { return "wigwag_stats"; }
+	};
+
+	struct ThreadPoolTaskExecutor
+	{
+		using ExecutorType = ::wigwag::thread_pool_task_executor;
+		static ::std::string GetName() { return "wigwag_pool"; }
+	};
+
+
+}}}
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef SRC_BENCHMARKS_DESCRIPTORS_SIGNALS_STD_HPP
+#define SRC_BENCHMARKS_DESCRIPTORS_SIGNALS_STD_HPP
+
+
+#include <functional>
+#include <string>
+#include <vector>
+
+
+namespace descriptors {
+namespace signal {
+namespace std
+{
+
+	// A baseline for the invocation costs: the handlers are just called one by one and are never disconnected
+	template < typename Signature_ >
+	class FunctionsVector
+	{
+		using FuncType = ::std::function<Signature_>;
+
+	public:
+		struct Connection
+		{ };
+
+	private:
+		::std::vector<FuncType>		_handlers;
+
+	public:
+		FunctionsVector()
+			: _handlers()
+		{ }
+
+		Connection connect(const FuncType& handler)
+		{
+			_handlers.push_back(handler);
+			return Connection();
+		}
+
+		template < typename... Args_ >
+		void operator() (Args_&&... args) const
+		{
+			for (const auto& h : _handlers)
+				h(args...);
+		}
+	};
+
+
+	struct Vector
+	{
+		using SignalType = FunctionsVector<void()>;
+		using HandlerType = ::std::function<void()>;
+		using ConnectionType = SignalType::Connection;
+
+		static HandlerType MakeHandler() { return []{}; }
+		static ::std::string GetName() { return "std_vector"; }
+	};
+
+}}}
+
+#endif
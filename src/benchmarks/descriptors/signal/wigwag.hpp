@@ -3,6 +3,7 @@
 
 
 #include <wigwag/signal.hpp>
+#include <wigwag/static_signal.hpp>
 
 
 namespace descriptors {
@@ -27,6 +28,72 @@ namespace wigwag
 	};
 
 
+	struct Flat
+	{
+		using SignalType = wigwag::signal<void(), handlers_storage::flat_vector>;
+		using HandlerType = std::function<void()>;
+		using ConnectionType = token;
+
+		static HandlerType MakeHandler() { return []{}; }
+		static std::string GetName() { return "wigwag_flat"; }
+	};
+
+
+	struct CopyOnWrite
+	{
+		using SignalType = wigwag::signal<void(), threading::copy_on_write>;
+		using HandlerType = std::function<void()>;
+		using ConnectionType = token;
+
+		static HandlerType MakeHandler() { return []{}; }
+		static std::string GetName() { return "wigwag_cow"; }
+	};
+
+
+	struct RwMutex
+	{
+		using SignalType = wigwag::signal<void(), threading::own_rw_mutex>;
+		using HandlerType = std::function<void()>;
+		using ConnectionType = token;
+
+		static HandlerType MakeHandler() { return []{}; }
+		static std::string GetName() { return "wigwag_rw"; }
+	};
+
+
+	struct Inplace
+	{
+		using SignalType = wigwag::signal<void(), handler_function::inplace<>>;
+		using HandlerType = SignalType::handler_type;
+		using ConnectionType = token;
+
+		static HandlerType MakeHandler() { return []{}; }
+		static std::string GetName() { return "wigwag_inplace"; }
+	};
+
+
+	struct Pooled
+	{
+		using SignalType = wigwag::signal<void(), allocation::pooled>;
+		using HandlerType = std::function<void()>;
+		using ConnectionType = token;
+
+		static HandlerType MakeHandler() { return []{}; }
+		static std::string GetName() { return "wigwag_pooled"; }
+	};
+
+
+	struct HazardPointers
+	{
+		using SignalType = wigwag::signal<void(), life_assurance::hazard_pointers>;
+		using HandlerType = std::function<void()>;
+		using ConnectionType = token;
+
+		static HandlerType MakeHandler() { return []{}; }
+		static std::string GetName() { return "wigwag_hp"; }
+	};
+
+
 	struct Ui
 	{
 		using SignalType = ui_signal<void()>;
@@ -37,6 +104,22 @@ namespace wigwag
 		static std::string GetName() { return "wigwag_ui"; }
 	};
 
+
+	struct EmptyHandler
+	{
+		void operator() () const { }
+	};
+
+	struct Static
+	{
+		using SignalType = static_signal<EmptyHandler>;
+		using HandlerType = EmptyHandler;
+		using ConnectionType = token;
+
+		static HandlerType MakeHandler() { return HandlerType(); }
+		static std::string GetName() { return "wigwag_static"; }
+	};
+
 }}}
 
 #endif
@@ -9,11 +9,17 @@
 
 
 #include <benchmarks/BenchmarkApp.hpp>
+#include <benchmarks/AsyncSignalBenchmarks.hpp>
 #include <benchmarks/BenchmarkSuite.hpp>
+#include <benchmarks/BulkConnectBenchmarks.hpp>
+#include <benchmarks/ConcurrentSignalBenchmarks.hpp>
+#include <benchmarks/ExecutorBenchmarks.hpp>
 #include <benchmarks/FunctionBenchmarks.hpp>
 #include <benchmarks/GenericBenchmarks.hpp>
+#include <benchmarks/LifeTokenBenchmarks.hpp>
 #include <benchmarks/MutexBenchmarks.hpp>
 #include <benchmarks/SignalBenchmarks.hpp>
+#include <benchmarks/descriptors/executor/wigwag.hpp>
 #include <benchmarks/descriptors/function/boost.hpp>
 #include <benchmarks/descriptors/function/std.hpp>
 #include <benchmarks/descriptors/generic/boost.hpp>
@@ -24,6 +30,7 @@
 #include <benchmarks/descriptors/signal/boost.hpp>
 #include <benchmarks/descriptors/signal/qt5.hpp>
 #include <benchmarks/descriptors/signal/sigcpp.hpp>
+#include <benchmarks/descriptors/signal/std.hpp>
 #include <benchmarks/descriptors/signal/wigwag.hpp>
 
 #include <iostream>
@@ -39,9 +46,17 @@ int main(int argc, char* argv[])
         BenchmarkSuite s;
         s.RegisterBenchmarks<SignalBenchmarks,
             signal::wigwag::Regular,
+            signal::wigwag::Flat,
+            signal::wigwag::CopyOnWrite,
+            signal::wigwag::RwMutex,
+            signal::wigwag::Inplace,
+            signal::wigwag::Pooled,
+            signal::wigwag::HazardPointers,
             signal::wigwag::Ui,
+            signal::wigwag::Static,
             signal::boost::Regular,
-            signal::boost::Tracking
+            signal::boost::Tracking,
+            signal::std::Vector
 #if WIGWAG_BENCHMARKS_SIGCPP2
             , signal::sigcpp::Regular
 #endif
@@ -50,6 +65,34 @@ int main(int argc, char* argv[])
 #endif
             >();
 
+        s.RegisterBenchmarks<ConcurrentSignalBenchmarks,
+            signal::wigwag::Regular,
+            signal::wigwag::Flat,
+            signal::wigwag::CopyOnWrite,
+            signal::wigwag::RwMutex,
+            signal::wigwag::Pooled,
+            signal::wigwag::HazardPointers,
+            signal::boost::Regular>();
+
+        s.RegisterBenchmarks<AsyncSignalBenchmarks,
+            signal::wigwag::Regular,
+            signal::wigwag::CopyOnWrite,
+            signal::wigwag::Pooled,
+            signal::wigwag::HazardPointers>();
+
+        s.RegisterBenchmarks<BulkConnectBenchmarks,
+            signal::wigwag::Regular,
+            signal::wigwag::Flat,
+            signal::wigwag::CopyOnWrite,
+            signal::wigwag::Pooled>();
+
+        s.RegisterBenchmarks<ExecutorBenchmarks,
+            executor::wigwag::ThreadTaskExecutor,
+            executor::wigwag::PooledThreadTaskExecutor,
+            executor::wigwag::BoundedThreadTaskExecutor,
+            executor::wigwag::InstrumentedThreadTaskExecutor,
+            executor::wigwag::ThreadPoolTaskExecutor>();
+
         s.RegisterBenchmarks<FunctionBenchmarks,
             function::std::Regular,
             function::boost::Regular>();
@@ -65,6 +108,9 @@ int main(int argc, char* argv[])
             generic::boost::ConditionVariable,
             generic::wigwag::LifeToken>();
 
+        s.RegisterBenchmarks<LifeTokenBenchmarks,
+            generic::wigwag::LifeToken>();
+
         return BenchmarkApp(s).Run(argc, argv);
     }
     catch (const std::exception& ex)
@@ -13,21 +13,34 @@
 
 #include <wigwag/life_token.hpp>
 #include <wigwag/listenable.hpp>
+#include <wigwag/multi_token.hpp>
+#include <wigwag/rw_mutex.hpp>
 #include <wigwag/signal.hpp>
+#include <wigwag/static_signal.hpp>
+#include <wigwag/thread_pool_task_executor.hpp>
 #include <wigwag/thread_task_executor.hpp>
 #include <wigwag/threadless_task_executor.hpp>
 #include <wigwag/token_pool.hpp>
 
 #include <cxxtest/TestSuite.h>
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <iostream>
+#include <list>
+#include <set>
 #include <thread>
 
 #include <test/utils/mutexed.hpp>
 #include <test/utils/profiler.hpp>
 #include <test/utils/thread.hpp>
 
+#if WIGWAG_PLATFORM_POSIX
+#   include <wigwag/wakeup_fd.hpp>
+#   include <poll.h>
+#endif
+
 
 #if  defined(_MSC_VER) && _MSC_VER < 1900
 #   define HAS_STD_FUNCTION_MOVE_BUG 1
@@ -58,6 +71,16 @@ private:
         virtual void g(int i) { _g_impl(i); }
     };
 
+    struct weighted_adder
+    {
+        int*    sum;
+        int     weight;
+
+        weighted_adder(int* s, int w) : sum(s), weight(w) { }
+
+        void operator() (int x) const { *sum += x * weight; }
+    };
+
     class copy_ctor_counter
     {
     private:
@@ -171,6 +194,37 @@ public:
         TS_ASSERT_EQUALS(g_value, 87);
     }
 
+    static void test_static_signal()
+    {
+        {
+            static_signal<weighted_adder> s;
+            int sum = 0;
+
+            token t0 = s.connect(weighted_adder(&sum, 1));
+            s(3);
+            TS_ASSERT_EQUALS(sum, 3);
+
+            std::vector<weighted_adder> handlers(2, weighted_adder(&sum, 10));
+            multi_token mt = s.connect_many(handlers);
+            s(1);
+            TS_ASSERT_EQUALS(sum, 24);
+
+            t0.reset();
+            s(1);
+            TS_ASSERT_EQUALS(sum, 44);
+        }
+
+        {
+            static_signal<weighted_adder, state_populating::populator_only> s([](const weighted_adder& h) { h(5); });
+            int sum = 0;
+
+            token t = s.connect(weighted_adder(&sum, 2));
+            TS_ASSERT_EQUALS(sum, 10);
+            s(1);
+            TS_ASSERT_EQUALS(sum, 12);
+        }
+    }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     static void test_token()
@@ -200,10 +254,169 @@ public:
         tp.release();
         s();
         TS_ASSERT_EQUALS(counter, 102);
+
+        {
+            using h_type = const std::function<void(int)>&;
+
+            signal<void(int)> s1;
+            signal<void(int), exception_handling::default_, threading::default_, state_populating::populator_and_withdrawer> s2(std::make_pair([](h_type h){ h(1); }, [](h_type h){ h(-1); }));
+            token_pool pool;
+            int sum = 0;
+            for (int i = 0; i < 10; ++i)
+            {
+                pool += s1.connect([&](int x) { sum += x; });
+                pool += s2.connect([&](int x) { sum += 100 * x; });
+            }
+            TS_ASSERT_EQUALS(sum, 1000);
+            s1(1);
+            TS_ASSERT_EQUALS(sum, 1010);
+            pool.release();
+            TS_ASSERT_EQUALS(sum, 10);
+            s1(1);
+            s2(1);
+            TS_ASSERT_EQUALS(sum, 10);
+        }
+
+        {
+            signal<void()> s2;
+            token_pool pool;
+            std::atomic<int> calls(0);
+            {
+                std::vector<std::unique_ptr<thread>> threads;
+                for (int j = 0; j < 4; ++j)
+                    threads.emplace_back(new thread([&](const std::atomic<bool>&) { for (int i = 0; i < 100; ++i) pool += s2.connect([&] { ++calls; }); }));
+            }
+            s2();
+            TS_ASSERT_EQUALS(calls.load(), 400);
+            pool.release();
+            s2();
+            TS_ASSERT_EQUALS(calls.load(), 400);
+        }
+
+        {
+            std::shared_ptr<task_executor> worker = std::make_shared<thread_task_executor>();
+            signal<void()> s2;
+            token_pool pool;
+            mutexed<bool> handler_finished(false);
+            pool += s2.connect(worker, [&] { thread::sleep(200); pool += s2.connect([]{}); handler_finished.set(true); });
+            s2();
+            thread::sleep(100);
+            pool.release();
+            TS_ASSERT(handler_finished.get());
+        }
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+    static void test_connect_many()
+    {
+        {
+            signal<void(int)> s;
+            int sum = 0;
+            std::vector<std::function<void(int)>> handlers;
+            for (int i = 1; i <= 10; ++i)
+                handlers.push_back([&, i](int x) { sum += i * x; });
+
+            multi_token mt = s.connect_many(handlers);
+            TS_ASSERT_EQUALS(mt.size(), 10u);
+            s(1);
+            TS_ASSERT_EQUALS(sum, 55);
+
+            multi_token mt2 = s.connector().connect_many(std::list<std::function<void(int)>>(handlers.begin(), handlers.begin() + 2));
+            s(1);
+            TS_ASSERT_EQUALS(sum, 113);
+
+            mt.reset();
+            TS_ASSERT(mt.empty());
+            s(1);
+            TS_ASSERT_EQUALS(sum, 116);
+
+            mt2 = multi_token();
+            s(1);
+            TS_ASSERT_EQUALS(sum, 116);
+        }
+
+        {
+            using h_type = const std::function<void(int)>&;
+
+            signal<void(int), state_populating::populator_only> s([](h_type h) { h(1); });
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+            int sum = 0;
+            std::vector<std::function<void(int)>> handlers(3, [&](int x) { sum += x; });
+
+            multi_token mt = s.connect_many(worker, handlers);
+            TS_ASSERT_EQUALS(sum, 0);
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(sum, 3);
+            s(10);
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(sum, 33);
+            s(10);
+            mt.reset();
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(sum, 33);
+        }
+
+        {
+            signal<void(int), threading::copy_on_write> s;
+            int sum = 0;
+            std::vector<std::function<void(int)>> handlers(100, [&](int x) { sum += x; });
+            multi_token mt;
+            token t = s.connect([&](int) { if (mt.empty()) mt = s.connect_many(handlers); });
+
+            s(1);
+            TS_ASSERT_EQUALS(sum, 0);
+            s(1);
+            TS_ASSERT_EQUALS(sum, 100);
+            mt.reset();
+            s(1);
+            TS_ASSERT_EQUALS(sum, 100);
+        }
+
+        {
+            listenable<test_listener> l;
+            int f_value = 0;
+            std::vector<test_listener> listeners(5, test_listener([&] { ++f_value; }, [](int) { }));
+            multi_token mt = l.connect_many(listeners);
+            l.invoke([](const test_listener& f) { f.f(); });
+            TS_ASSERT_EQUALS(f_value, 5);
+        }
+    }
+
+    static void test_multi_token()
+    {
+        static_assert(std::is_nothrow_move_constructible<multi_token>::value && std::is_nothrow_move_assignable<multi_token>::value, "multi_token should be nothrow movable");
+
+        signal<void(int)> s1;
+        signal<void(int), exception_handling::default_, threading::copy_on_write> s2;
+        int sum1 = 0, sum2 = 0;
+
+        multi_token mt;
+        mt.reserve(20);
+        for (int i = 0; i < 10; ++i)
+        {
+            mt += s1.connect([&](int x) { sum1 += x; });
+            mt += s2.connect([&](int x) { sum2 += x; });
+        }
+        std::vector<std::function<void(int)>> handlers(5, [&](int x) { sum2 += x; });
+        mt += s2.connect_many(handlers);
+        TS_ASSERT_EQUALS(mt.size(), 25u);
+
+        token t = s2.connect([&](int x) { sum2 += x * 100; });
+        s1(1);
+        s2(1);
+        TS_ASSERT_EQUALS(sum1, 10);
+        TS_ASSERT_EQUALS(sum2, 115);
+
+        token releaser = s1.connect([&](int) { mt.reset(); });
+        s1(1);
+        TS_ASSERT(mt.empty());
+        s1(1);
+        s2(1);
+        TS_ASSERT_EQUALS(sum1, 20);
+        TS_ASSERT_EQUALS(sum2, 215);
+    }
+
     static void test_connect_from_handler()
     {
         {
@@ -519,7 +732,79 @@ public:
     { do__test__life_assurance__common<signal<void()>>(); }
 
     static void test__life_assurance__intrusive_life_tokens()
-    { do__test__life_assurance__common<signal<void(), exception_handling::default_, threading::default_, state_populating::default_, life_assurance::intrusive_life_tokens>>(); }
+    {
+        using intrusive_signal = signal<void(), exception_handling::default_, threading::default_, state_populating::default_, life_assurance::intrusive_life_tokens>;
+
+        do__test__life_assurance__common<intrusive_signal>();
+        do__test__life_assurance__common<signal<void(), life_assurance::basic_intrusive_life_tokens<0>>>();
+
+        {
+            intrusive_signal s;
+            const int tokens_count = 32;
+            std::vector<std::shared_ptr<task_executor>> workers;
+            std::vector<token> tokens;
+            std::atomic<int> calls_after_release(0);
+            std::unique_ptr<std::atomic<bool>[]> released(new std::atomic<bool>[tokens_count]);
+            for (int i = 0; i < tokens_count; ++i)
+            {
+                released[i] = false;
+                workers.push_back(std::make_shared<thread_task_executor>());
+                tokens.push_back(s.connect(workers.back(), [&, i]{ thread::sleep(i % 4); if (released[i]) ++calls_after_release; }));
+            }
+
+            {
+                thread th([&](const std::atomic<bool>& alive) { while (alive) s(); });
+                thread::sleep(100);
+
+                std::vector<std::unique_ptr<thread>> releasers;
+                for (int j = 0; j < 4; ++j)
+                    releasers.emplace_back(new thread([&, j](const std::atomic<bool>&)
+                        {
+                            for (int i = j; i < tokens_count; i += 4)
+                            {
+                                tokens[i].reset();
+                                released[i] = true;
+                            }
+                        }));
+            }
+
+            TS_ASSERT_EQUALS(calls_after_release.load(), 0);
+        }
+    }
+
+    static void test__life_assurance__hazard_pointers()
+    {
+        using hp_signal = signal<void(), exception_handling::default_, threading::default_, state_populating::default_, life_assurance::hazard_pointers>;
+
+        do__test__life_assurance__common<hp_signal>();
+
+        {
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+            hp_signal s;
+            int counter = 0;
+            token t = s.connect(worker, [&]{ ++counter; });
+            s();
+            t.reset();
+            t = s.connect(worker, [&]{ counter += 10; });
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(counter, 0);
+            s();
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(counter, 10);
+        }
+
+        {
+            hp_signal s;
+            std::vector<token> tokens;
+            int counter = 0;
+            std::function<void(int)> nested_emission = [&](int depth) { if (depth < 40) { ++counter; tokens.push_back(s.connect([]{})); s(); } };
+            int depth = 0;
+            tokens.push_back(s.connect([&]{ nested_emission(++depth); }));
+            s();
+            TS_ASSERT_EQUALS(counter, 39);
+            tokens.clear();
+        }
+    }
 
     template < typename Signal_ >
     static void do__test__life_assurance__common()
@@ -690,6 +975,60 @@ public:
         TS_ASSERT(handler_invoked);
     }
 
+    static void test__life_assurance__disconnect_during_emission()
+    {
+        do__test__life_assurance__disconnect_during_emission<signal<void()>>();
+        do__test__life_assurance__disconnect_during_emission<signal<void(), handlers_storage::flat_vector>>();
+        do__test__life_assurance__disconnect_during_emission<signal<void(), life_assurance::single_threaded>>();
+        do__test__life_assurance__disconnect_during_emission<signal<void(), life_assurance::hazard_pointers>>();
+        do__test__life_assurance__disconnect_during_emission<signal<void(), life_assurance::hazard_pointers, handlers_storage::flat_vector>>();
+        do__test__life_assurance__disconnect_during_emission<signal<void(), life_assurance::none>>();
+        do__test__life_assurance__disconnect_during_emission<signal<void(), life_assurance::none, handlers_storage::flat_vector>>();
+    }
+
+    template < typename Signal_ >
+    static void do__test__life_assurance__disconnect_during_emission()
+    {
+        Signal_ s;
+
+        int first_count = 0, second_count = 0, third_count = 0;
+        token second_t, third_t;
+        token first_t = s.connect([&]
+            {
+                ++first_count;
+                second_t.reset();
+                if (first_count == 1)
+                    third_t = s.connect([&] { ++third_count; });
+            });
+        second_t = s.connect([&] { ++second_count; });
+
+        s();
+        TS_ASSERT_EQUALS(first_count, 1);
+        TS_ASSERT_EQUALS(second_count, 0);
+
+        s();
+        TS_ASSERT_EQUALS(first_count, 2);
+        TS_ASSERT_EQUALS(second_count, 0);
+        TS_ASSERT_EQUALS(third_count, 1);
+
+        first_t.reset();
+        third_t.reset();
+        s();
+        TS_ASSERT_EQUALS(first_count, 2);
+
+        int others_count = 0;
+        std::vector<token> others;
+        token clearing_t = s.connect([&] { others.clear(); });
+        for (int i = 0; i < 100; ++i)
+            others.push_back(s.connect([&] { ++others_count; }));
+        token last_t = s.connect([&] { ++others_count; });
+
+        s();
+        TS_ASSERT_EQUALS(others_count, 1);
+        s();
+        TS_ASSERT_EQUALS(others_count, 2);
+    }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     static void test__creation__ahead_of_time()
@@ -726,6 +1065,293 @@ public:
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+    static void test__threading__copy_on_write()
+    {
+        using cow_signal = signal<void(), exception_handling::default_, threading::copy_on_write>;
+
+        do__test__life_assurance__common<cow_signal>();
+
+        {
+            signal<void(), threading::copy_on_write, handlers_storage::flat_vector> s;
+            do__test__threading__concurrent_invoke(s);
+        }
+
+        {
+            cow_signal s;
+            token_pool tp;
+            int counter = 0;
+            std::unique_ptr<token> t2;
+            tp += s.connect([&]{ t2.reset(); tp += s.connect([&] { ++counter; }); });
+            t2.reset(new token(s.connect([&] { counter += 100; })));
+            s();
+            TS_ASSERT_EQUALS(counter, 0);
+            s();
+            TS_ASSERT_EQUALS(counter, 1);
+        }
+    }
+
+    static void test__threading__own_rw_mutex()
+    {
+        signal<void(), threading::own_rw_mutex> s;
+        do__test__threading__concurrent_invoke(s);
+    }
+
+    static void test__threading__shared_rw_mutex()
+    {
+        signal<void(), threading::shared_rw_mutex> s(std::make_shared<rw_mutex>());
+        do__test__threading__concurrent_invoke(s);
+    }
+
+    template < typename Signal_ >
+    static void do__test__threading__concurrent_invoke(Signal_& s)
+    {
+        {
+            token t = s.connect([]{ thread::sleep(300); });
+            profiler p;
+            {
+                thread th1([&](const std::atomic<bool>&) { s(); });
+                thread th2([&](const std::atomic<bool>&) { s(); });
+            }
+            auto invoke_time = duration_cast<milliseconds>(p.reset()).count();
+            TS_ASSERT_LESS_THAN_EQUALS(invoke_time, 500);
+        }
+
+        {
+            std::atomic<int> counter(0);
+            thread th([&](const std::atomic<bool>& alive) { while (alive) s(); });
+            for (int i = 0; i < 1000; ++i)
+            {
+                token t = s.connect([&] { ++counter; });
+                thread::sleep(0);
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    static void test__handlers_storage__intrusive_list()
+    {
+        signal<void(), handlers_storage::intrusive_list> s;
+
+        int counter = 0;
+        token t1 = s.connect([&]{ ++counter; });
+        token t2 = s.connect([&]{ ++counter; });
+        s();
+        t1.reset();
+        s();
+        TS_ASSERT_EQUALS(counter, 3);
+    }
+
+    static void test__handlers_storage__flat_vector()
+    {
+        {
+            signal<void(), handlers_storage::flat_vector> s;
+
+            std::string res;
+            std::vector<token> tokens;
+            for (char c = 'a'; c <= 'h'; ++c)
+                tokens.push_back(s.connect([&, c]{ res += c; }));
+
+            s();
+            TS_ASSERT_EQUALS(res, "abcdefgh");
+
+            res.clear();
+            for (size_t i = 1; i < tokens.size(); i += 2)
+                tokens[i].reset();
+            tokens[2].reset();
+            s();
+            TS_ASSERT_EQUALS(res, "aeg");
+
+            res.clear();
+            tokens.push_back(s.connect([&]{ res += 'i'; }));
+            s();
+            TS_ASSERT_EQUALS(res, "aegi");
+        }
+        {
+            signal<void(), handlers_storage::flat_vector> s;
+
+            std::string res;
+            token t1, t2, t3;
+            t1 = s.connect([&]{ res += 'a'; t2.reset(); t3.reset(); });
+            t2 = s.connect([&]{ res += 'b'; });
+            t3 = s.connect([&]{ res += 'c'; });
+            s();
+            s();
+            TS_ASSERT_EQUALS(res, "aa");
+        }
+        {
+            signal<void(), handlers_storage::flat_vector> s;
+
+            int counter = 0;
+            std::vector<token> tokens;
+            tokens.push_back(s.connect([&]
+                {
+                    if (tokens.size() == 2)
+                        for (int i = 0; i < 100; ++i)
+                            tokens.push_back(s.connect([&] { ++counter; }));
+                } ));
+            tokens.push_back(s.connect([&] { ++counter; }));
+            s();
+            TS_ASSERT_EQUALS(counter, 1);
+
+            for (size_t i = 1; i < tokens.size(); i += 2)
+                tokens[i].reset();
+            s();
+            TS_ASSERT_EQUALS(counter, 51);
+        }
+        {
+            listenable<test_listener, handlers_storage::flat_vector> l;
+
+            int counter = 0;
+            token t = l.connect(test_listener([&] { ++counter; }, [](int) {}));
+            l.invoke([](const test_listener& f) { f.f(); });
+            t.reset();
+            l.invoke([](const test_listener& f) { f.f(); });
+            TS_ASSERT_EQUALS(counter, 1);
+        }
+    }
+
+    static void test__allocation__heap()
+    { do__test__allocation__common<allocation::heap>(); }
+
+    static void test__allocation__pooled()
+    { do__test__allocation__common<allocation::pooled>(); }
+
+    template < typename AllocationPolicy_ >
+    static void do__test__allocation__common()
+    {
+        {
+            signal<void(int), AllocationPolicy_> s;
+
+            int sum = 0;
+            std::vector<token> tokens;
+            for (int i = 0; i < 1000; ++i)
+                tokens.push_back(s.connect([&, i](int x) { sum += x; }, i % 2 ? handler_attributes::suppress_populator : handler_attributes::none));
+            s(1);
+            TS_ASSERT_EQUALS(sum, 1000);
+
+            for (size_t i = 0; i < tokens.size(); i += 2)
+                tokens[i].reset();
+            s(1);
+            TS_ASSERT_EQUALS(sum, 1500);
+        }
+        {
+            signal<void(), AllocationPolicy_> s;
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+
+            int counter = 0;
+            token t = s.connect(worker, [&]{ ++counter; });
+            s();
+            t.reset();
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(counter, 0);
+        }
+        {
+            signal<void(int), AllocationPolicy_> s;
+            std::shared_ptr<task_executor> worker = std::make_shared<basic_thread_task_executor<AllocationPolicy_>>();
+
+            std::atomic<int> sum(0);
+            token t = s.connect(worker, [&](int x) { sum += x; });
+            for (int i = 0; i < 100; ++i)
+                s(1);
+            for (int i = 0; i < 100 && sum != 100; ++i)
+                thread::sleep(10);
+            TS_ASSERT_EQUALS(sum.load(), 100);
+        }
+        {
+            signal<void(), AllocationPolicy_> s;
+
+            std::mutex m;
+            std::vector<token> tokens;
+            auto connect_func = [&](const std::atomic<bool>& alive)
+                {
+                    while (alive)
+                    {
+                        token t = s.connect([]{ });
+                        std::lock_guard<std::mutex> l(m);
+                        tokens.push_back(std::move(t));
+                        if (tokens.size() > 100)
+                            tokens.clear();
+                    }
+                };
+            {
+                thread th1(connect_func), th2(connect_func), th3(connect_func);
+                thread::sleep(200);
+            }
+            s();
+        }
+        {
+            listenable<std::function<void()>, AllocationPolicy_> l;
+
+            int counter = 0;
+            token t = l.connect([&]{ ++counter; });
+            l.invoke([](const std::function<void()>& f) { f(); });
+            TS_ASSERT_EQUALS(counter, 1);
+        }
+    }
+
+    static void test__handler_function__std_function()
+    {
+        signal<void(int), handler_function::std_function> s;
+        static_assert(std::is_same<decltype(s)::handler_type, std::function<void(int)>>::value, "Unexpected handler_type");
+
+        int sum = 0;
+        token t = s.connect([&](int i) { sum += i; });
+        s(1);
+        s(2);
+        TS_ASSERT_EQUALS(sum, 3);
+    }
+
+    static void test__handler_function__inplace()
+    {
+        {
+            signal<void(int), handler_function::inplace<>> s;
+
+            int sum = 0;
+            int factor = 10;
+            token t1 = s.connect([&](int i) { sum += i * factor; });
+            s(1);
+            TS_ASSERT_EQUALS(sum, 10);
+
+            std::array<int, 16> big_capture = { { 1, 2, 3 } };
+            token t2 = s.connect([&sum, big_capture](int i) { sum += i * big_capture[2]; });
+            s(2);
+            TS_ASSERT_EQUALS(sum, 36);
+
+            t1.reset();
+            s(3);
+            TS_ASSERT_EQUALS(sum, 45);
+        }
+        {
+            signal<void(const std::string&), handler_function::inplace<32>> s;
+
+            std::string res;
+            std::shared_ptr<std::string> suffix = std::make_shared<std::string>("!");
+            token t = s.connect([&res, suffix](const std::string& str) { res += str + *suffix; });
+            suffix.reset();
+            s("a");
+            token t2 = s.connector().connect([&res](const std::string& str) { res += str; });
+            s("b");
+            TS_ASSERT_EQUALS(res, "a!b!b");
+        }
+        {
+            signal<void(int), handler_function::inplace<>> s([](const signal<void(int), handler_function::inplace<>>::handler_type& h) { h(42); });
+
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+            int sum = 0;
+            token t1 = s.connect([&](int i) { sum += i; });
+            token t2 = s.connect(worker, [&](int i) { sum += i; });
+            TS_ASSERT_EQUALS(sum, 42);
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(sum, 84);
+            s(1);
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(sum, 86);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
     static void test_life_token()
     {
         {
@@ -817,6 +1443,34 @@ public:
             TS_ASSERT_LESS_THAN_EQUALS(move_time, 100);
             TS_ASSERT_LESS_THAN_EQUALS(release_time, 100);
         }
+
+        for (int spin_count : { 0, 1000 })
+        {
+            life_token lt(spin_count);
+            life_token::checker lc(lt);
+            std::atomic<bool> released(false);
+            std::atomic<int> calls_after_release(0);
+
+            {
+                thread th(
+                    [&](const std::atomic<bool>& alive)
+                    {
+                        while (alive)
+                        {
+                            life_token::execution_guard g(lc);
+                            if (g.is_alive() && released)
+                                ++calls_after_release;
+                        }
+                    });
+
+                thread::sleep(50);
+                lt.release();
+                released = true;
+                thread::sleep(50);
+            }
+
+            TS_ASSERT_EQUALS(calls_after_release.load(), 0);
+        }
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -866,10 +1520,579 @@ public:
             TS_ASSERT_EQUALS(n, 3);
         }
 
+        {
+            const int producers_count = 8;
+            const int tasks_per_producer = 10000;
+
+            std::vector<int> last_values(producers_count, -1);
+            std::atomic<bool> ordered(true);
+            {
+                std::shared_ptr<task_executor> worker = std::make_shared<thread_task_executor>();
+
+                std::vector<std::thread> producers;
+                for (int i = 0; i < producers_count; ++i)
+                    producers.emplace_back([&, i] {
+                            for (int j = 0; j < tasks_per_producer; ++j)
+                                worker->add_task([&, i, j] {
+                                        if (last_values[i] + 1 != j)
+                                            ordered = false;
+                                        last_values[i] = j;
+                                    });
+                        });
+
+                for (auto& t : producers)
+                    t.join();
+            }
+
+            TS_ASSERT(ordered);
+            for (int v : last_values)
+                TS_ASSERT_EQUALS(v, tasks_per_producer - 1);
+        }
+    }
+
+    static void test_thread_pool_task_executor()
+    {
+        {
+            auto worker = std::make_shared<thread_pool_task_executor>(4);
+            TS_ASSERT_EQUALS(worker->get_threads_count(), 4u);
+
+            std::mutex m;
+            std::set<std::thread::id> thread_ids;
+
+            for (int i = 0; i < 4; ++i)
+                worker->add_task([&] {
+                        thread::sleep(200);
+                        auto l = lock(m);
+                        thread_ids.insert(std::this_thread::get_id());
+                    });
+
+            profiler p;
+            worker.reset();
+            auto worker_dtor_time = duration_cast<milliseconds>(p.reset()).count();
+            TS_ASSERT_LESS_THAN(worker_dtor_time, 500);
+            auto l = lock(m);
+            TS_ASSERT_EQUALS(thread_ids.size(), 4u);
+            TS_ASSERT_EQUALS(thread_ids.count(std::this_thread::get_id()), 0u);
+        }
+
+        {
+            const int producers_count = 4;
+            const int tasks_per_producer = 10000;
+
+            std::atomic<int> counter(0);
+            {
+                thread_pool_task_executor worker(3, true);
+
+                std::vector<std::thread> producers;
+                for (int i = 0; i < producers_count; ++i)
+                    producers.emplace_back([&] {
+                            for (int j = 0; j < tasks_per_producer; ++j)
+                                worker.add_task([&, j] {
+                                        ++counter;
+                                        if (j % 2 == 0)
+                                            worker.add_task([&] { ++counter; });
+                                    });
+                        });
+
+                for (auto& t : producers)
+                    t.join();
+            }
+            TS_ASSERT_EQUALS(counter, producers_count * tasks_per_producer * 3 / 2);
+        }
+
+        {
+            std::shared_ptr<task_executor> worker = std::make_shared<thread_pool_task_executor>(2);
+            signal<void(int)> s;
+
+            std::atomic<int> sum(0);
+            token t = s.connect(worker, [&](int i) { sum += i; });
+            for (int i = 1; i <= 100; ++i)
+                s(i);
+
+            thread::sleep(200);
+            TS_ASSERT_EQUALS(sum, 5050);
+        }
+    }
+
+    static void test_task_executor_batching()
+    {
+        class counting_executor : public threadless_task_executor
+        {
+        public:
+            int add_task_calls = 0;
+            std::vector<size_t> add_tasks_sizes;
+
+            virtual void add_task(task t)
+            {
+                ++add_task_calls;
+                threadless_task_executor::add_task(std::move(t));
+            }
+
+            virtual void add_tasks(task* tasks, size_t count)
+            {
+                add_tasks_sizes.push_back(count);
+                threadless_task_executor::add_tasks(tasks, count);
+            }
+        };
+
+        auto worker1 = std::make_shared<counting_executor>();
+        auto worker2 = std::make_shared<counting_executor>();
+
+        signal<void(int)> s;
+        std::vector<int> values;
+        token_pool tp;
+        for (int i = 0; i < 10; ++i)
+        {
+            tp += s.connect(worker1, [&, i](int x) { values.push_back(i * x); });
+            tp += s.connect(worker2, [&, i](int x) { values.push_back(-i * x); });
+        }
+        tp += s.connect([&](int) { });
+
+        s(2);
+        TS_ASSERT_EQUALS(worker1->add_task_calls, 0);
+        TS_ASSERT_EQUALS(worker2->add_task_calls, 0);
+        TS_ASSERT(worker1->add_tasks_sizes == std::vector<size_t>{ 10 });
+        TS_ASSERT(worker2->add_tasks_sizes == std::vector<size_t>{ 10 });
+
+        worker1->process_tasks();
+        TS_ASSERT(values == (std::vector<int>{ 0, 2, 4, 6, 8, 10, 12, 14, 16, 18 }));
+
+        {
+            auto w = std::make_shared<threadless_task_executor>();
+            w->set_capacity(1, overflow_policy::fail);
+
+            signal<void(), exception_handling::none> s2;
+            int counter = 0;
+            token_pool tp2;
+            tp2 += s2.connect(w, [&] { ++counter; });
+            tp2 += s2.connect(w, [&] { ++counter; });
+            tp2 += s2.connect([] { throw std::runtime_error("Test exception"); });
+
+            TS_ASSERT_THROWS(s2(), std::runtime_error);
+            TS_ASSERT_EQUALS(w->get_pending_tasks_count(), 0u);
+            w->process_tasks();
+            TS_ASSERT_EQUALS(counter, 0);
+        }
+        {
+            auto w1 = std::make_shared<threadless_task_executor>();
+            auto w2 = std::make_shared<threadless_task_executor>();
+            w1->set_capacity(1, overflow_policy::fail);
+
+            signal<void()> s2;
+            int counter1 = 0, counter2 = 0;
+            token_pool tp2;
+            tp2 += s2.connect(w1, [&] { ++counter1; });
+            tp2 += s2.connect(w1, [&] { ++counter1; });
+            tp2 += s2.connect(w2, [&] { ++counter2; });
+
+            TS_ASSERT_THROWS(s2(), std::runtime_error);
+            w1->process_tasks();
+            w2->process_tasks();
+            TS_ASSERT_EQUALS(counter1, 1);
+            TS_ASSERT_EQUALS(counter2, 1);
+            TS_ASSERT_EQUALS(w1->get_dropped_tasks_count(), 1u);
+        }
+
+        {
+            std::atomic<int> counter(0);
+            {
+                thread_task_executor w;
+                std::vector<task> tasks(1000, [&] { ++counter; });
+                w.add_tasks(tasks.data(), tasks.size());
+                w.add_tasks(nullptr, 0);
+            }
+            TS_ASSERT_EQUALS(counter, 1000);
+        }
+        {
+            std::atomic<int> counter(0);
+            {
+                thread_pool_task_executor w(3);
+                std::vector<task> tasks(1000, [&] { ++counter; });
+                w.add_tasks(tasks.data(), tasks.size());
+                w.add_tasks(nullptr, 0);
+            }
+            TS_ASSERT_EQUALS(counter, 1000);
+        }
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+    static void test_conflating_handler()
+    {
+        {
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+            signal<void(int)> s;
+            std::vector<int> values;
+
+            token t = s.connect(worker, [&](int i) { values.push_back(i); }, handler_attributes::conflate);
+            s(1);
+            s(2);
+            s(3);
+            TS_ASSERT_EQUALS(worker->get_pending_tasks_count(), 1u);
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(values.size(), 1u);
+            TS_ASSERT_EQUALS(values.back(), 3);
+
+            s(4);
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(values.size(), 2u);
+            TS_ASSERT_EQUALS(values.back(), 4);
+
+            s(5);
+            t.reset();
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(values.size(), 2u);
+        }
+
+        {
+            using h_type = const std::function<void(int)>&;
+
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+            signal<void(int), state_populating::populator_only> s([](h_type h) { h(1); });
+            int sum = 0, conflated_sum = 0;
+
+            token t0 = s.connect(worker, [&](int i) { sum += i; });
+            token t1 = s.connect(worker, [&](int i) { conflated_sum += i; }, handler_attributes::conflate);
+            s(10);
+            s(100);
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(sum, 111);
+            TS_ASSERT_EQUALS(conflated_sum, 100);
+        }
+
+        {
+            std::shared_ptr<thread_task_executor> worker = std::make_shared<thread_task_executor>();
+            signal<void(int)> s;
+            std::atomic<int> calls(0), last_value(0);
+
+            token t = s.connect(worker, [&](int i) { thread::sleep(10); ++calls; last_value = i; }, handler_attributes::conflate);
+            for (int i = 1; i <= 1000; ++i)
+                s(i);
+            for (int i = 0; i < 500 && last_value != 1000; ++i)
+                thread::sleep(10);
+
+            TS_ASSERT_EQUALS(last_value.load(), 1000);
+            TS_ASSERT_LESS_THAN(calls.load(), 100);
+        }
+
+        for (overflow_policy policy : { overflow_policy::drop_newest, overflow_policy::drop_oldest })
+        {
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+            worker->set_capacity(1, policy);
+            signal<void(int)> s;
+            std::vector<int> values;
+
+            token t = s.connect(worker, [&](int i) { values.push_back(i); }, handler_attributes::conflate);
+            if (policy == overflow_policy::drop_newest)
+            {
+                worker->add_task([]{ });
+                s(1);
+            }
+            else
+            {
+                s(1);
+                worker->add_task([]{ });
+            }
+            TS_ASSERT_EQUALS(worker->get_dropped_tasks_count(), 1u);
+            worker->process_tasks();
+            TS_ASSERT(values.empty());
+
+            s(2);
+            s(3);
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(values.size(), 1u);
+            TS_ASSERT_EQUALS(values.back(), 3);
+        }
+    }
+
+    static void test_threadless_task_executor_bounded_processing()
+    {
+        std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+        std::vector<int> order;
+
+        for (int i = 0; i < 10; ++i)
+            worker->add_task([&, i] { order.push_back(i); });
+
+        TS_ASSERT_EQUALS(worker->process_tasks(3), 7u);
+        TS_ASSERT_EQUALS(order.size(), 3u);
+        TS_ASSERT_EQUALS(worker->get_pending_tasks_count(), 7u);
+
+        worker->add_task([&] { order.push_back(10); worker->add_task([&] { order.push_back(11); }); });
+        TS_ASSERT_EQUALS(worker->process_tasks(0), 8u);
+        TS_ASSERT_EQUALS(worker->process_tasks_until(std::chrono::steady_clock::now() - std::chrono::seconds(1)), 8u);
+        TS_ASSERT_EQUALS(order.size(), 3u);
+
+        TS_ASSERT_EQUALS(worker->process_tasks(5), 3u);
+        TS_ASSERT_EQUALS(worker->process_tasks_until(std::chrono::steady_clock::now() + std::chrono::hours(1)), 0u);
+        TS_ASSERT_EQUALS(order.size(), 12u);
+        for (int i = 0; i < 12; ++i)
+            TS_ASSERT_EQUALS(order[i], i);
+
+        worker->add_task([&] { order.push_back(12); });
+        worker->process_tasks();
+        TS_ASSERT_EQUALS(order.size(), 13u);
+        TS_ASSERT_EQUALS(worker->get_pending_tasks_count(), 0u);
+    }
+
+    static void test_bounded_task_executors()
+    {
+        {
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+            worker->set_capacity(3, overflow_policy::drop_newest);
+            std::vector<int> values;
+            for (int i = 0; i < 5; ++i)
+                worker->add_task([&, i] { values.push_back(i); });
+            TS_ASSERT_EQUALS(worker->get_pending_tasks_count(), 3u);
+            TS_ASSERT_EQUALS(worker->get_dropped_tasks_count(), 2u);
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(values.size(), 3u);
+            TS_ASSERT_EQUALS(values.back(), 2);
+
+            worker->add_task([&] { values.push_back(10); });
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(values.back(), 10);
+        }
+
+        {
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+            worker->set_capacity(3, overflow_policy::drop_oldest);
+            std::vector<int> values;
+            for (int i = 0; i < 10; ++i)
+                worker->add_task([&, i] { values.push_back(i); });
+            TS_ASSERT_EQUALS(worker->get_pending_tasks_count(), 3u);
+            TS_ASSERT_EQUALS(worker->get_dropped_tasks_count(), 7u);
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(values.size(), 3u);
+            TS_ASSERT_EQUALS(values[0], 7);
+            TS_ASSERT_EQUALS(values[2], 9);
+
+            values.clear();
+            worker->add_task([&] { values.push_back(100); for (int i = 0; i < 5; ++i) worker->add_task([&, i] { values.push_back(i); }); });
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(values.size(), 4u);
+            TS_ASSERT_EQUALS(values[1], 2);
+        }
+
+        {
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+            worker->set_capacity(4, overflow_policy::drop_oldest);
+            std::string order;
+            worker->add_task([&]
+                {
+                    order += 'A';
+                    for (char c = 'C'; c <= 'F'; ++c)
+                        worker->add_task([&, c] { order += c; });
+                });
+            worker->add_task([&] { order += 'B'; });
+            worker->process_tasks(1);
+            TS_ASSERT_EQUALS(worker->get_dropped_tasks_count(), 1u);
+            worker->add_task([&] { order += 'G'; });
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(order, "ADEFG");
+        }
+
+        {
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+            worker->set_capacity(1, overflow_policy::fail);
+            worker->add_task([] { });
+            TS_ASSERT_THROWS(worker->add_task([] { }), std::runtime_error);
+            TS_ASSERT_EQUALS(worker->get_dropped_tasks_count(), 1u);
+            worker->process_tasks();
+            TS_ASSERT_THROWS_NOTHING(worker->add_task([] { }));
+        }
+
+        {
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+            worker->set_capacity(2, overflow_policy::fail);
+            std::string order;
+            std::vector<task> tasks;
+            for (char c = 'a'; c <= 'e'; ++c)
+                tasks.push_back([&, c] { order += c; });
+            TS_ASSERT_THROWS(worker->add_tasks(tasks.data(), tasks.size()), std::runtime_error);
+            TS_ASSERT_EQUALS(worker->get_pending_tasks_count(), 2u);
+            TS_ASSERT_EQUALS(worker->get_dropped_tasks_count(), 3u);
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(order, "ab");
+        }
+
+        {
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+            worker->set_capacity(2, overflow_policy::block);
+            std::atomic<int> added(0);
+            {
+                thread t([&](const std::atomic<bool>&) { for (int i = 0; i < 10; ++i) { worker->add_task([] { }); ++added; } });
+                thread::sleep(100);
+                TS_ASSERT_EQUALS(added.load(), 2);
+                TS_ASSERT_EQUALS(worker->get_blocked_tasks_count(), 1u);
+                for (int i = 0; i < 500 && added != 10; ++i)
+                {
+                    worker->process_tasks();
+                    thread::sleep(1);
+                }
+            }
+            TS_ASSERT_EQUALS(added.load(), 10);
+            TS_ASSERT_EQUALS(worker->process_tasks(100), 0u);
+        }
+
+        {
+            std::shared_ptr<thread_task_executor> worker = std::make_shared<thread_task_executor>();
+            worker->set_capacity(4, overflow_policy::drop_newest);
+            std::atomic<bool> release(false);
+            std::atomic<int> executed(0);
+            worker->add_task([&] { while (!release) thread::sleep(1); });
+            thread::sleep(50);
+            for (int i = 0; i < 10; ++i)
+                worker->add_task([&] { ++executed; });
+            TS_ASSERT_EQUALS(worker->get_dropped_tasks_count(), 6u);
+            release = true;
+            for (int i = 0; i < 500 && executed != 4; ++i)
+                thread::sleep(1);
+            thread::sleep(50);
+            TS_ASSERT_EQUALS(executed.load(), 4);
+        }
+
+        {
+            std::shared_ptr<thread_task_executor> worker = std::make_shared<thread_task_executor>();
+            TS_ASSERT_THROWS(worker->set_capacity(4, overflow_policy::drop_oldest), std::runtime_error);
+        }
+
+        {
+            std::shared_ptr<thread_task_executor> worker = std::make_shared<thread_task_executor>();
+            worker->set_capacity(2, overflow_policy::block);
+            std::atomic<int> executed(0);
+            for (int i = 0; i < 100; ++i)
+                worker->add_task([&] { thread::sleep(1); ++executed; });
+            for (int i = 0; i < 1000 && executed != 100; ++i)
+                thread::sleep(1);
+            TS_ASSERT_EQUALS(executed.load(), 100);
+            TS_ASSERT_LESS_THAN(0u, worker->get_blocked_tasks_count());
+        }
+    }
+
+    static void test_executor_statistics()
+    {
+        {
+            std::shared_ptr<thread_task_executor> worker = std::make_shared<thread_task_executor>();
+            worker->add_task([] { });
+            thread::sleep(50);
+            TS_ASSERT_EQUALS(worker->get_statistics().tasks_count, 0u);
+        }
+
+        {
+            std::shared_ptr<thread_task_executor> worker = std::make_shared<thread_task_executor>();
+            worker->set_capacity(100, overflow_policy::drop_newest);
+            worker->enable_statistics();
+
+            std::atomic<bool> release(false);
+            std::atomic<int> executed(0);
+            worker->add_task([&] { while (!release) thread::sleep(1); });
+            thread::sleep(50);
+
+            std::vector<task> tasks;
+            for (int i = 0; i < 50; ++i)
+                tasks.push_back([&] { ++executed; thread::sleep(1); });
+            worker->add_tasks(tasks.data(), tasks.size());
+            for (int i = 0; i < 60; ++i)
+                worker->add_task([&] { ++executed; });
+
+            executor_statistics stats = worker->get_statistics();
+            TS_ASSERT_EQUALS(stats.queue_depth, 100u);
+            TS_ASSERT_EQUALS(stats.max_queue_depth, 100u);
+            TS_ASSERT_EQUALS(stats.tasks_count, 0u);
+
+            release = true;
+            for (int i = 0; i < 1000 && worker->get_statistics().tasks_count != 101; ++i)
+                thread::sleep(1);
+
+            stats = worker->get_statistics();
+            TS_ASSERT_EQUALS(executed.load(), 100);
+            TS_ASSERT_EQUALS(stats.tasks_count, 101u);
+            TS_ASSERT_EQUALS(stats.dropped_tasks_count, 10u);
+            TS_ASSERT_EQUALS(stats.queue_depth, 0u);
+
+            std::uint64_t waits = 0, runs = 0;
+            for (std::size_t i = 0; i < executor_statistics::histogram_size; ++i)
+            {
+                waits += stats.wait_times[i];
+                runs += stats.run_times[i];
+            }
+            TS_ASSERT_EQUALS(waits, 101u);
+            TS_ASSERT_EQUALS(runs, 101u);
+            TS_ASSERT(executor_statistics::get_percentile(stats.run_times, 0.9) >= std::chrono::milliseconds(1));
+            TS_ASSERT(executor_statistics::get_percentile(stats.run_times, 1.0) >= std::chrono::milliseconds(50));
+            TS_ASSERT(executor_statistics::get_percentile(stats.wait_times, 1.0) >= std::chrono::milliseconds(10));
+            TS_ASSERT_LESS_THAN(0.0, stats.get_busy_ratio());
+            TS_ASSERT_LESS_THAN_EQUALS(stats.get_busy_ratio(), 1.0);
+            TS_ASSERT_LESS_THAN(0.0, stats.get_tasks_per_second());
+        }
+
+        {
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+            worker->set_capacity(3, overflow_policy::drop_oldest);
+            worker->enable_statistics();
+            for (int i = 0; i < 5; ++i)
+                worker->add_task([] { });
+
+            executor_statistics stats = worker->get_statistics();
+            TS_ASSERT_EQUALS(stats.queue_depth, 3u);
+            TS_ASSERT_EQUALS(stats.max_queue_depth, 3u);
+            TS_ASSERT_EQUALS(stats.dropped_tasks_count, 2u);
+
+            worker->process_tasks();
+            stats = worker->get_statistics();
+            TS_ASSERT_EQUALS(stats.queue_depth, 0u);
+            TS_ASSERT_EQUALS(stats.tasks_count, 3u);
+        }
+
+        {
+            std::shared_ptr<thread_pool_task_executor> worker = std::make_shared<thread_pool_task_executor>(2);
+            worker->enable_statistics();
+            std::vector<task> tasks(50, [] { thread::sleep(1); });
+            worker->add_tasks(tasks.data(), tasks.size());
+            for (int i = 0; i < 50; ++i)
+                worker->add_task([] { });
+            for (int i = 0; i < 1000 && worker->get_statistics().tasks_count != 100; ++i)
+                thread::sleep(1);
+
+            executor_statistics stats = worker->get_statistics();
+            TS_ASSERT_EQUALS(stats.tasks_count, 100u);
+            TS_ASSERT_EQUALS(stats.queue_depth, 0u);
+            TS_ASSERT_LESS_THAN(0u, stats.max_queue_depth);
+            TS_ASSERT(executor_statistics::get_percentile(stats.run_times, 1.0) >= std::chrono::milliseconds(1));
+        }
+    }
+
+    static void test_threadless_task_executor_wakeup()
+    {
+#if WIGWAG_PLATFORM_POSIX
+        wakeup_fd fd;
+        auto is_readable = [&](int timeout_ms) { pollfd p = { fd.get_fd(), POLLIN, 0 }; return poll(&p, 1, timeout_ms) == 1; };
+
+        std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+        worker->set_wakeup_handler([&] { fd.notify(); });
+        int counter = 0;
+
+        TS_ASSERT(!is_readable(0));
+        worker->add_task([&] { ++counter; });
+        TS_ASSERT(is_readable(0));
+        fd.clear();
+        TS_ASSERT(!is_readable(0));
+
+        worker->add_task([&] { ++counter; });
+        TS_ASSERT(!is_readable(0));
+        worker->process_tasks();
+        TS_ASSERT_EQUALS(counter, 2);
+
+        {
+            thread t([&](const std::atomic<bool>&) { thread::sleep(50); worker->add_task([&] { ++counter; }); });
+            TS_ASSERT(is_readable(5000));
+            fd.clear();
+            worker->process_tasks();
+        }
+        TS_ASSERT_EQUALS(counter, 3);
+#endif
+    }
+
     static void test_task_executor_function_copying()
     {
 #if !HAS_STD_FUNCTION_MOVE_BUG
@@ -893,6 +2116,41 @@ public:
 #endif
     }
 
+    static void test_task_executor_compatibility()
+    {
+        class legacy_executor : public function_task_executor
+        {
+        public:
+            std::vector<std::function<void()>> tasks;
+
+            virtual void add_task(std::function<void()> f)
+            { tasks.push_back(std::move(f)); }
+        };
+
+        auto worker = std::make_shared<legacy_executor>();
+        signal<void(int)> s;
+        int sum = 0;
+        token t = s.connect(worker, [&](int x) { sum += x; });
+
+        s(1);
+        s(2);
+        std::shared_ptr<task_executor> base_worker = worker;
+        base_worker->add_task([&] { sum += 10; });
+        base_worker->add_task(std::function<void()>([&] { sum += 20; }));
+        TS_ASSERT_EQUALS(worker->tasks.size(), 4u);
+        for (const auto& f : worker->tasks)
+            f();
+        TS_ASSERT_EQUALS(sum, 33);
+        static_assert(std::is_abstract<task_executor>::value, "task_executor should be abstract");
+
+        std::array<int, 64> big_state;
+        big_state.fill(1);
+        auto threadless_worker = std::make_shared<threadless_task_executor>();
+        threadless_worker->add_task([&sum, big_state] { for (int x : big_state) sum += x; });
+        threadless_worker->process_tasks();
+        TS_ASSERT_EQUALS(sum, 97);
+    }
+
     static void test_signal_handler_copying()
     {
 #if !HAS_STD_FUNCTION_MOVE_BUG
@@ -916,11 +2174,11 @@ public:
             token t = s.connect(worker, copy_ctor_counter(counter), handler_attributes::suppress_populator);
             TS_ASSERT_EQUALS(counter.load(), 0);
             s();
-            TS_ASSERT_EQUALS(counter.load(), 1);
+            TS_ASSERT_EQUALS(counter.load(), 0);
             worker->process_tasks();
-            TS_ASSERT_EQUALS(counter.load(), 1);
+            TS_ASSERT_EQUALS(counter.load(), 0);
             t.reset();
-            TS_ASSERT_EQUALS(counter.load(), 1);
+            TS_ASSERT_EQUALS(counter.load(), 0);
         }
 
         {
@@ -929,15 +2187,15 @@ public:
             std::atomic<int> counter(0);
 
             token t = s.connect(worker, copy_ctor_counter(counter));
-            TS_ASSERT_EQUALS(counter.load(), 1);
+            TS_ASSERT_EQUALS(counter.load(), 0);
             worker->process_tasks();
-            TS_ASSERT_EQUALS(counter.load(), 1);
+            TS_ASSERT_EQUALS(counter.load(), 0);
             s();
-            TS_ASSERT_EQUALS(counter.load(), 2);
+            TS_ASSERT_EQUALS(counter.load(), 0);
             worker->process_tasks();
-            TS_ASSERT_EQUALS(counter.load(), 2);
+            TS_ASSERT_EQUALS(counter.load(), 0);
             t.reset();
-            TS_ASSERT_EQUALS(counter.load(), 2);
+            TS_ASSERT_EQUALS(counter.load(), 0);
         }
 #endif
     }
@@ -993,7 +2251,46 @@ public:
             t.reset();
             TS_ASSERT_EQUALS(counter.load(), 2);
         }
+
+        {
+            std::shared_ptr<threadless_task_executor> worker1 = std::make_shared<threadless_task_executor>();
+            std::shared_ptr<threadless_task_executor> worker2 = std::make_shared<threadless_task_executor>();
+            std::atomic<int> counter(0);
+            signal<void(const copy_ctor_counter&)> s;
+
+            int invoked = 0;
+            token_pool tp;
+            for (int i = 0; i < 5; ++i)
+            {
+                tp += s.connect(worker1, [&](const copy_ctor_counter& c) { c(); ++invoked; });
+                tp += s.connect(worker2, [&](const copy_ctor_counter& c) { c(); ++invoked; });
+                tp += s.connect([&](const copy_ctor_counter& c) { c(); });
+            }
+
+            s(copy_ctor_counter(counter));
+            TS_ASSERT_EQUALS(counter.load(), 1);
+            worker1->process_tasks();
+            worker2->process_tasks();
+            TS_ASSERT_EQUALS(counter.load(), 1);
+            TS_ASSERT_EQUALS(invoked, 10);
+        }
 #endif
+
+        {
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+            signal<void(std::string&)> s;
+
+            std::vector<std::string> results;
+            token_pool tp;
+            for (int i = 0; i < 2; ++i)
+                tp += s.connect(worker, [&](std::string& str) { str += "!"; results.push_back(str); });
+
+            std::string str = "qwe";
+            s(str);
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(str, "qwe");
+            TS_ASSERT(results == (std::vector<std::string>{ "qwe!", "qwe!" }));
+        }
     }
 };
 
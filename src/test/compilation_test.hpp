@@ -9,7 +9,10 @@
 
 
 #include <wigwag/listenable.hpp>
+#include <wigwag/rw_mutex.hpp>
 #include <wigwag/signal.hpp>
+#include <wigwag/static_signal.hpp>
+#include <wigwag/thread_pool_task_executor.hpp>
 #include <wigwag/thread_task_executor.hpp>
 #include <wigwag/threadless_task_executor.hpp>
 #include <wigwag/token_pool.hpp>
@@ -106,6 +109,9 @@ public:
 
         tp += on_func.connect(worker, std::bind(&crazy_signals::func_handler, this, std::placeholders::_1));
         tp += on_string_ref.connect(worker, std::bind(&crazy_signals::string_ref_handler, this, std::placeholders::_1));
+
+        std::shared_ptr<task_executor>  pool = std::make_shared<thread_pool_task_executor>(2, true);
+        tp += on_func.connect(pool, std::bind(&crazy_signals::func_handler, this, std::placeholders::_1));
     }
 
     void test_invoke()
@@ -131,19 +137,44 @@ public:
     signal<void(), threading::shared_recursive_mutex> s2;
     signal<void(), life_assurance::none, state_populating::none> s3;
     signal<void(), threading::shared_recursive_mutex, creation::lazy> s4;
+    signal<void(), handlers_storage::flat_vector> s5;
+    signal<void(), threading::copy_on_write> s6;
+    signal<void(), threading::own_rw_mutex> s7;
+    signal<void(), handler_function::inplace<>> s8;
+    signal<void(), allocation::pooled> s9;
+    signal<void(), life_assurance::hazard_pointers> s10;
 
     listenable<std::function<void()>, exception_handling::none> l1;
     listenable<std::function<void()>, threading::shared_recursive_mutex> l2;
     listenable<std::function<void()>, life_assurance::none, state_populating::none> l3;
+    listenable<std::function<void()>, handlers_storage::flat_vector> l4;
+    listenable<std::function<void()>, threading::copy_on_write> l5;
+    listenable<std::function<void()>, threading::shared_rw_mutex> l6;
+    listenable<std::function<void()>, allocation::pooled> l7;
+
+    static_signal<std::function<void(int)>> ss1;
+    static_signal<std::function<void()>, exception_handling::none, threading::none, life_assurance::none> ss2;
 
     instantiations_test()
         :   s1(),
             s2(std::make_shared<std::recursive_mutex>()),
             s3(),
             s4(std::make_shared<std::recursive_mutex>()),
+            s5(),
+            s6(),
+            s7(),
+            s8(),
+            s9(),
+            s10(),
             l1(),
             l2(std::make_shared<std::recursive_mutex>()),
-            l3()
+            l3(),
+            l4(),
+            l5(),
+            l6(std::make_shared<rw_mutex>()),
+            l7(),
+            ss1(),
+            ss2()
     { }
 
     void f()
@@ -152,9 +183,27 @@ public:
         s2.connect([]{});
         s3.connect([]{});
         s4.connect([]{});
+        s5.connect([]{});
+        s6.connect([]{});
+        s7.connect([]{});
+        s8.connect([]{});
+        s9.connect([]{});
+        s10.connect([]{});
         l1.connect([]{});
         l2.connect([]{});
         l3.connect([]{});
+        l4.connect([]{});
+        l5.connect([]{});
+        l6.connect([]{});
+        l7.connect([]{});
+        ss1.connect([](int){});
+        ss2.connect([]{});
+
+        std::vector<std::function<void()>> handlers(2, []{});
+        s3.connect_many(handlers);
+        s6.connect_many(std::make_shared<threadless_task_executor>(), handlers);
+        s9.connector().connect_many(handlers);
+        l4.connect_many(handlers);
     }
 
     void f() const
@@ -163,8 +212,20 @@ public:
         s2();
         s3();
         s4();
+        s5();
+        s6();
+        s7();
+        s8();
+        s9();
+        s10();
         l1.invoke([](const std::function<void()>& f){ f(); });
         l2.invoke([](const std::function<void()>& f){ f(); });
         l3.invoke([](const std::function<void()>& f){ f(); });
+        l4.invoke([](const std::function<void()>& f){ f(); });
+        l5.invoke([](const std::function<void()>& f){ f(); });
+        l6.invoke([](const std::function<void()>& f){ f(); });
+        l7.invoke([](const std::function<void()>& f){ f(); });
+        ss1(42);
+        ss2();
     }
 };